@@ -25,6 +25,9 @@ class I2CBus : public II2CBus
 
     std::mutex& mutex() noexcept override final;
 
+    // True if a device ACKs the given 7-bit address
+    bool probe(std::uint8_t address) noexcept;
+
   private:
     i2c_master_bus_handle_t m_handle;
     std::mutex m_mutex;
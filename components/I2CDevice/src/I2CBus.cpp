@@ -38,4 +38,12 @@ std::mutex& I2CBus::mutex() noexcept
     return m_mutex;
 }
 
+bool I2CBus::probe(std::uint8_t address) noexcept
+{
+    constexpr int kProbeTimeoutMs = 50;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return i2c_master_probe(m_handle, address, kProbeTimeoutMs) == ESP_OK;
+}
+
 } // namespace muc
@@ -0,0 +1,59 @@
+#ifndef COMPONENTS_FONTS_AFFINE_H
+#define COMPONENTS_FONTS_AFFINE_H
+
+#include <cstdint>
+
+#include "PageBitmap.h"
+
+namespace muc::fonts
+{
+
+// Q16.16 fixed point: 1.0 == kFixedOne
+constexpr std::int32_t kFixedOne = 1 << 16;
+
+constexpr std::int32_t to_fixed(int value) noexcept
+{
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(value) << 16);
+}
+
+// sin/cos of whole degrees in Q16.16, from a quarter-wave table (no floating point)
+std::int32_t sin_fixed(int degrees) noexcept;
+std::int32_t cos_fixed(int degrees) noexcept;
+
+// 2D affine map in Q16.16 fixed point, in screen orientation (y grows downwards):
+//   x' = xx * x + xy * y + tx
+//   y' = yx * x + yy * y + ty
+struct Affine
+{
+    std::int32_t xx, xy, tx;
+    std::int32_t yx, yy, ty;
+
+    static Affine identity() noexcept;
+    static Affine translation(std::int32_t x, std::int32_t y) noexcept;
+    // Clockwise on screen for positive angles
+    static Affine rotation(int degrees) noexcept;
+    static Affine scaling(std::int32_t x, std::int32_t y) noexcept;
+    // x' = x + x_per_y * y, y' = y + y_per_x * x
+    static Affine shearing(std::int32_t x_per_y, std::int32_t y_per_x) noexcept;
+
+    // `rhs` first, then this
+    Affine operator*(const Affine& rhs) const noexcept;
+
+    // False if the map is singular (collapses onto a line or point) or so close to it
+    // that the inverse does not fit Q16.16
+    bool invert(Affine& out) const noexcept;
+};
+
+// Draws the set pixels of `source` into `target` through `to_target`, which maps source
+// coordinates to target coordinates.
+//
+// Works backwards: every target pixel inside the bounding box of the mapped source (and the
+// target) has its centre mapped into the source and takes the pixel it lands on. Output
+// has no holes at any angle or scale, and each pixel costs two integer additions.
+void blit_affine(const PageBitmap& target,
+                 const PageBitmap& source,
+                 const Affine& to_target) noexcept;
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_AFFINE_H
@@ -0,0 +1,52 @@
+#ifndef COMPONENTS_FONTS_FONT_ATLAS_H
+#define COMPONENTS_FONTS_FONT_ATLAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "FontMetrics.h"
+#include "PackedGlyph.h"
+
+namespace muc::fonts
+{
+
+// One size of the embedded TTF, rasterized at build time by tools/font_atlas into
+// font_atlas_data.cpp. Glyphs are sorted by codepoint; their column bytes live in one
+// shared bitmap table. Kerning pairs are sorted by (left, right) and only list non-zero
+// adjustments.
+struct AtlasFont
+{
+    int pixel_size;
+    int ascender;    // baseline -> top of the tallest glyph
+    int line_height; // baseline-to-baseline distance
+    std::span<const std::uint32_t> codepoints;
+    std::span<const PackedGlyph> glyphs; // glyphs[i] draws codepoints[i]
+    std::span<const KerningPair> kerning_pairs;
+    PackedGlyph fallback; // .notdef, as FreeType draws missing characters
+
+    // Glyph of `codepoint`, or the fallback if the font does not contain it
+    const PackedGlyph* glyph(std::uint32_t codepoint) const noexcept;
+
+    GlyphMetrics metrics(std::uint32_t codepoint) const noexcept;
+
+    // Pen adjustment between `left` and `right` when drawn next to each other
+    int kerning(std::uint32_t left, std::uint32_t right) const noexcept;
+
+    FontMetrics font_metrics() const noexcept
+    {
+        return FontMetrics{.pixel_size = pixel_size,
+                           .ascender = ascender,
+                           .line_height = line_height};
+    }
+};
+
+// All sizes in the atlas, in the order the build listed them
+std::span<const AtlasFont* const> atlas_fonts() noexcept;
+
+// Atlas font of exactly `pixel_size`, or nullptr
+const AtlasFont* find_atlas_font(int pixel_size) noexcept;
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_FONT_ATLAS_H
@@ -0,0 +1,32 @@
+#ifndef COMPONENTS_FONTS_FONT_MEMORY_H
+#define COMPONENTS_FONTS_FONT_MEMORY_H
+
+#include <cstdint>
+
+#include <ft2build.h>
+#include FT_SYSTEM_H
+
+namespace muc::fonts
+{
+
+struct FontMemoryStats
+{
+    std::uint32_t total_bytes; // CONFIG_FONTS_FREETYPE_ARENA_BYTES
+    std::uint32_t used_bytes;  // live blocks, headers included
+    std::uint32_t peak_bytes;  // high-water mark of used_bytes since boot
+    std::uint32_t largest_free_block;
+    std::uint32_t allocations; // live blocks
+    std::uint32_t failed;      // requests the arena could not serve
+};
+
+// FT_Memory handing out blocks of one static arena shared by every FontRenderer.
+//
+// FreeType never touches the general heap, so fonts cannot fragment it, and running out
+// is a hard FT_Err_Out_Of_Memory instead of a random failure elsewhere. Thread-safe.
+FT_Memory font_memory() noexcept;
+
+FontMemoryStats font_memory_stats() noexcept;
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_FONT_MEMORY_H
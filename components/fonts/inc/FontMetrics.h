@@ -0,0 +1,39 @@
+#ifndef COMPONENTS_FONTS_FONT_METRICS_H
+#define COMPONENTS_FONTS_FONT_METRICS_H
+
+#include <cstdint>
+
+namespace muc::fonts
+{
+
+// Size-wide metrics, in pixels
+struct FontMetrics
+{
+    int pixel_size;
+    int ascender;    // baseline -> top of the tallest glyph
+    int line_height; // baseline-to-baseline distance
+};
+
+// Placement of one glyph without its bitmap; the same numbers as the PackedGlyph that
+// glyph() returns for it
+struct GlyphMetrics
+{
+    int width;
+    int rows;
+    int left; // pen -> left edge of the bitmap
+    int top;  // baseline -> top row of the bitmap (up is positive)
+    int advance;
+};
+
+// Horizontal adjustment between two neighbouring characters, e.g. the negative offset
+// that tucks "o" under "T"
+struct KerningPair
+{
+    std::uint32_t left;
+    std::uint32_t right;
+    std::int16_t x;
+};
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_FONT_METRICS_H
@@ -7,12 +7,14 @@
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 
+#include "FontMetrics.h"
+#include "GlyphCache.h"
+#include "GlyphRaster.h"
+#include "Utf8.h"
+
 namespace muc::fonts
 {
 
-// Decodes UTF-8 and advances the pointer
-std::uint32_t decode_utf8(const char*& p);
-
 class FontRenderer
 {
   public:
@@ -25,8 +27,57 @@ class FontRenderer
 
     bool init(const std::uint8_t* data, std::size_t size, int pixel_size) noexcept;
 
+    // Switches the size glyph() renders at; glyphs of other sizes stay cached
+    void set_pixel_size(int pixel_size) noexcept;
+
+    int pixel_size() const noexcept
+    {
+        return m_pixel_size;
+    }
+
+    // Switches how glyphs are rasterized (initially the CONFIG_FONTS_RASTER_* choice);
+    // drops every cached glyph
+    void set_raster_options(const RasterOptions& options) noexcept;
+
+    const RasterOptions& raster_options() const noexcept
+    {
+        return m_raster;
+    }
+
+    // True if the font has its own glyph for `codepoint` (glyph() draws .notdef otherwise)
+    bool has_glyph(std::uint32_t codepoint) const noexcept
+    {
+        return face && FT_Get_Char_Index(face, codepoint) != 0;
+    }
+
+    // Glyph of `codepoint` at the current pixel size, rasterized by FreeType on the first
+    // request and served from the cache afterwards. Valid until the next glyph() call;
+    // nullptr if the font cannot render it. Clipped to a cache slot (kGlyphSlotBytes),
+    // which drops rows silently above about 24 px.
+    const PackedGlyph* glyph(std::uint32_t codepoint) noexcept;
+
+    // Metrics of the glyph glyph() would return, from the outline alone: nothing is
+    // rasterized or cached. All zero if the font cannot load it.
+    GlyphMetrics metrics(std::uint32_t codepoint) noexcept;
+
+    // Pen adjustment between `left` and `right` at the current size, from the font's
+    // kern table
+    int kerning(std::uint32_t left, std::uint32_t right) const noexcept;
+
+    FontMetrics font_metrics() const noexcept;
+
+    GlyphCacheStats cache_stats() const noexcept
+    {
+        return m_cache.stats();
+    }
+
     FT_Library library;
     FT_Face face;
+
+  private:
+    int m_pixel_size = 0;
+    RasterOptions m_raster;
+    GlyphCache m_cache;
 };
 
 } // namespace muc::fonts
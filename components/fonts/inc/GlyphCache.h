@@ -0,0 +1,76 @@
+#ifndef COMPONENTS_FONTS_GLYPH_CACHE_H
+#define COMPONENTS_FONTS_GLYPH_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "PackedGlyph.h"
+
+namespace muc::fonts
+{
+
+// Arena geometry: every slot holds one packed bitmap of up to kGlyphSlotBytes, e.g. a
+// 16 px wide glyph of 32 rows or a 21 px wide glyph of 24 rows. Larger glyphs are
+// clipped without notice: above about 24 px sizes lose bottom rows, and glyphs wider
+// than 64 px also their right columns.
+constexpr std::size_t kGlyphCacheSlots = 32;
+constexpr std::size_t kGlyphSlotBytes = 64;
+
+struct GlyphCacheStats
+{
+    std::uint32_t hits;
+    std::uint32_t misses;
+    std::uint32_t evictions;
+};
+
+// Fixed-size store of rasterized glyphs keyed by (codepoint, pixel size).
+//
+// All memory lives in the object; when every slot is taken, allocate() reuses the
+// least recently used one. Not thread-safe: one cache per FontRenderer and task.
+class GlyphCache
+{
+  public:
+    GlyphCache() noexcept = default;
+
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    // Cached glyph or nullptr; counts a hit or a miss
+    const PackedGlyph* find(std::uint32_t codepoint, int pixel_size) noexcept;
+
+    // Slot for a new glyph of `width` x `rows`; `columns` receives its zeroed column bytes.
+    // Rows that do not fit a slot are dropped (the returned glyph reports the clipped
+    // height); the caller fills in the remaining metrics.
+    PackedGlyph* allocate(std::uint32_t codepoint,
+                          int pixel_size,
+                          int width,
+                          int rows,
+                          std::uint8_t*& columns) noexcept;
+
+    void clear() noexcept;
+
+    GlyphCacheStats stats() const noexcept
+    {
+        return m_stats;
+    }
+
+  private:
+    struct Slot
+    {
+        PackedGlyph glyph;
+        std::uint32_t codepoint;
+        std::uint8_t pixel_size;
+        std::uint32_t last_used; // m_clock at the last find()/allocate()
+        bool valid;
+    };
+
+    std::array<Slot, kGlyphCacheSlots> m_slots{};
+    std::array<std::uint8_t, kGlyphCacheSlots * kGlyphSlotBytes> m_arena{};
+    std::uint32_t m_clock = 0;
+    GlyphCacheStats m_stats{};
+};
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_GLYPH_CACHE_H
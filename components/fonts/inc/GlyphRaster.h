@@ -0,0 +1,108 @@
+#ifndef COMPONENTS_FONTS_GLYPH_RASTER_H
+#define COMPONENTS_FONTS_GLYPH_RASTER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "PackedGlyph.h"
+
+namespace muc::fonts
+{
+
+// How FreeType's output becomes the 1-bit pixels of a PackedGlyph
+enum class RasterMode : std::uint8_t
+{
+    Threshold, // anti-aliased coverage; pixels above the threshold are set
+    Dither,    // anti-aliased coverage through a 4x4 ordered dither centred on the threshold
+    Mono,      // FreeType's 1-bit rasterizer, with hinting tuned for 1-bit output
+};
+
+struct RasterOptions
+{
+    RasterMode mode = RasterMode::Threshold;
+    std::uint8_t threshold = kCoverageThreshold; // unused by Mono
+};
+
+// FT_Load_Char() flags that hint (and with `render`, rasterize) for `mode`. Loads without
+// rendering yield the same metrics as the rendered glyph.
+inline FT_Int32 raster_load_flags(RasterMode mode, bool render = true) noexcept
+{
+    const FT_Int32 target =
+        mode == RasterMode::Mono ? FT_LOAD_TARGET_MONO : FT_LOAD_TARGET_NORMAL;
+    return target | (render ? FT_LOAD_RENDER : FT_LOAD_DEFAULT);
+}
+
+// Thresholds of a 4x4 ordered dither around `threshold`, indexed (row % 4) * 4 + col % 4:
+// the 16 cells of the Bayer matrix spread evenly over the largest range centred on it
+inline std::array<std::uint8_t, 16> dither_thresholds(std::uint8_t threshold) noexcept
+{
+    constexpr std::uint8_t kBayer4[16] = {0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5};
+
+    const int range = threshold < 128 ? threshold : 255 - threshold;
+    std::array<std::uint8_t, 16> out{};
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        // Rounded down, so a coverage of exactly `threshold` sets half of the cells
+        out[i] = static_cast<std::uint8_t>(threshold + (((2 * kBayer4[i] - 15) * range) >> 4));
+    }
+    return out;
+}
+
+// Packs a bitmap FreeType rendered with raster_load_flags(options.mode) into page layout.
+// 1-bit bitmaps are copied; coverage is thresholded or dithered. `out` must hold
+// packed_glyph_bytes(width, rows) zeroes.
+inline void pack_bitmap(const FT_Bitmap& bitmap,
+                        const RasterOptions& options,
+                        std::uint8_t* out) noexcept
+{
+    const auto width = static_cast<int>(bitmap.width);
+    const auto rows = static_cast<int>(bitmap.rows);
+
+    if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+    {
+        for (int row = 0; row < rows; ++row)
+        {
+            const std::uint8_t* src = bitmap.buffer + row * bitmap.pitch;
+            std::uint8_t* dst = out + (row >> 3) * width;
+            const auto bit = static_cast<std::uint8_t>(1u << (row & 7));
+            for (int col = 0; col < width; ++col)
+            {
+                if (src[col >> 3] & (0x80u >> (col & 7)))
+                {
+                    dst[col] |= bit;
+                }
+            }
+        }
+        return;
+    }
+
+    if (options.mode != RasterMode::Dither)
+    {
+        pack_coverage(bitmap.buffer, bitmap.pitch, width, rows, options.threshold, out);
+        return;
+    }
+
+    const std::array<std::uint8_t, 16> thresholds = dither_thresholds(options.threshold);
+    for (int row = 0; row < rows; ++row)
+    {
+        const std::uint8_t* src = bitmap.buffer + row * bitmap.pitch;
+        const std::uint8_t* cell = thresholds.data() + (row & 3) * 4;
+        std::uint8_t* dst = out + (row >> 3) * width;
+        const auto bit = static_cast<std::uint8_t>(1u << (row & 7));
+        for (int col = 0; col < width; ++col)
+        {
+            if (src[col] > cell[col & 3])
+            {
+                dst[col] |= bit;
+            }
+        }
+    }
+}
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_GLYPH_RASTER_H
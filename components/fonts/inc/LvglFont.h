@@ -0,0 +1,58 @@
+#ifndef COMPONENTS_FONTS_LVGL_FONT_H
+#define COMPONENTS_FONTS_LVGL_FONT_H
+
+#include <cstdint>
+
+#include "FontRenderer.h"
+#include "lvgl.h"
+
+namespace muc::fonts
+{
+
+// lv_font_t that rasterizes glyphs on demand through a FontRenderer (CONFIG_FONTS_FREETYPE).
+//
+// Only the glyphs LVGL actually draws are rendered, and they live in the renderer's bounded
+// GlyphCache, so one embedded TTF serves every size for the RAM of what is on screen.
+// Several LvglFonts of different sizes may share one renderer; characters missing from the
+// TTF are left to the fallback font. Like every LVGL object it must only be used from the
+// LVGL context, and the renderer must not be used by other tasks meanwhile.
+//
+//   static LvglFont s_font;
+//   s_font.init(renderer, 12);
+//   lv_obj_set_style_text_font(label, s_font.font(), 0);
+class LvglFont
+{
+  public:
+    LvglFont() noexcept = default;
+
+    LvglFont(const LvglFont&) = delete;
+    LvglFont& operator=(const LvglFont&) = delete;
+
+    // `renderer` must be initialized and outlive the font
+    bool init(FontRenderer& renderer,
+              int pixel_size,
+              const lv_font_t* fallback = LV_FONT_DEFAULT) noexcept;
+
+    const lv_font_t* font() const noexcept
+    {
+        return &m_font;
+    }
+
+  private:
+    static bool get_glyph_dsc(const lv_font_t* font,
+                              lv_font_glyph_dsc_t* dsc,
+                              std::uint32_t letter,
+                              std::uint32_t letter_next);
+    static const void* get_glyph_bitmap(lv_font_glyph_dsc_t* dsc, lv_draw_buf_t* draw_buf);
+
+    // Cached glyph of `codepoint` at this font's size
+    const PackedGlyph* glyph(std::uint32_t codepoint) noexcept;
+
+    FontRenderer* m_renderer = nullptr;
+    int m_pixel_size = 0;
+    lv_font_t m_font{};
+};
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_LVGL_FONT_H
@@ -0,0 +1,68 @@
+#ifndef COMPONENTS_FONTS_PACKED_GLYPH_H
+#define COMPONENTS_FONTS_PACKED_GLYPH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace muc::fonts
+{
+
+// 1-bit glyph in SSD1306 page layout: the bitmap is split into bands ("pages") of 8 rows,
+// each stored as `width` column bytes with bit 0 = top row of the band. Used by both the
+// build-time atlas and the FreeType glyph cache.
+struct PackedGlyph
+{
+    const std::uint8_t* columns; // pages() * width bytes
+    std::uint8_t width;
+    std::uint8_t rows;
+    std::int8_t left;    // pen -> left edge of the bitmap
+    std::int8_t top;     // baseline -> top row of the bitmap (up is positive)
+    std::int16_t advance;
+
+    int pages() const noexcept
+    {
+        return (rows + 7) / 8;
+    }
+
+    bool pixel(int col, int row) const noexcept
+    {
+        return (columns[(row >> 3) * width + col] & (1u << (row & 7))) != 0;
+    }
+};
+
+constexpr std::size_t packed_glyph_bytes(int width, int rows) noexcept
+{
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>((rows + 7) / 8);
+}
+
+// Packs an 8-bit coverage bitmap (FreeType FT_PIXEL_MODE_GRAY) into page layout, setting
+// every pixel above `threshold`. `out` must hold packed_glyph_bytes(width, rows) zeroes.
+inline void pack_coverage(const std::uint8_t* coverage,
+                          int pitch,
+                          int width,
+                          int rows,
+                          std::uint8_t threshold,
+                          std::uint8_t* out) noexcept
+{
+    for (int row = 0; row < rows; ++row)
+    {
+        const std::uint8_t* src = coverage + row * pitch;
+        std::uint8_t* dst = out + (row >> 3) * width;
+        const auto bit = static_cast<std::uint8_t>(1u << (row & 7));
+        for (int col = 0; col < width; ++col)
+        {
+            if (src[col] > threshold)
+            {
+                dst[col] |= bit;
+            }
+        }
+    }
+}
+
+// Default coverage above which an anti-aliased pixel is drawn on the 1-bit panel
+// (CONFIG_FONTS_RASTER_COVERAGE_THRESHOLD, see GlyphRaster.h)
+constexpr std::uint8_t kCoverageThreshold = 64;
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_PACKED_GLYPH_H
@@ -0,0 +1,48 @@
+#ifndef COMPONENTS_FONTS_PAGE_BITMAP_H
+#define COMPONENTS_FONTS_PAGE_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ssd1306.h"
+
+namespace muc::fonts
+{
+
+// Writable 1-bit bitmap in SSD1306 page layout: pixel (x, y) is bit y % 8 of byte
+// (y / 8) * width + x. The Oled framebuffer is one; offscreen bitmaps use the same layout
+// so everything that draws into one can draw into the other.
+struct PageBitmap
+{
+    std::uint8_t* data; // bytes(width, height) bytes
+    int width;
+    int height;
+
+    static constexpr std::size_t bytes(int width, int height) noexcept
+    {
+        return static_cast<std::size_t>(width) * static_cast<std::size_t>((height + 7) / 8);
+    }
+
+    bool pixel(int x, int y) const noexcept
+    {
+        return (data[(y >> 3) * width + x] & (1u << (y & 7))) != 0;
+    }
+
+    void clear() const noexcept
+    {
+        std::memset(data, 0, bytes(width, height));
+    }
+};
+
+// The visible window of `oled`
+inline PageBitmap page_bitmap(ssd1306::Oled& oled) noexcept
+{
+    return PageBitmap{.data = oled.framebuffer().data(),
+                      .width = oled.geometry().width,
+                      .height = oled.geometry().height};
+}
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_PAGE_BITMAP_H
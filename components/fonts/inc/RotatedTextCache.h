@@ -0,0 +1,95 @@
+#ifndef COMPONENTS_FONTS_ROTATED_TEXT_CACHE_H
+#define COMPONENTS_FONTS_ROTATED_TEXT_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "FontRenderer.h"
+#include "PageBitmap.h"
+#include "TextLayout.h"
+
+namespace muc::fonts
+{
+
+// One frame per step: a 3 degree step is the finest
+constexpr std::size_t kMaxRotatedFrames = 120;
+
+struct RotatedTextStats
+{
+    std::uint32_t hits;
+    std::uint32_t misses;
+    std::uint32_t uncached;    // frames rendered but not stored: storage was full
+    std::uint32_t frames;      // angles stored so far
+    std::size_t bytes_used;    // of the frame storage
+    std::size_t bytes_total;
+};
+
+// Frames of a text rotated about the centre of its ink, rendered once per angle.
+//
+// A miss rasterizes every glyph through FreeType with its outline rotated by
+// FT_Set_Transform (hinted at the upright size, in the font's RasterMode) and keeps
+// the page-aligned box of the result in `storage`; a hit is a clear and a copy of those
+// pages. Frames are stored in the order they are first drawn; once the storage is full,
+// the remaining angles are rendered on every request. Not thread-safe, and the FontRenderer
+// must not be used by another task meanwhile (its transform is set during a miss).
+class RotatedTextCache
+{
+  public:
+    explicit RotatedTextCache(std::span<std::uint8_t> storage) noexcept;
+
+    RotatedTextCache(const RotatedTextCache&) = delete;
+    RotatedTextCache& operator=(const RotatedTextCache&) = delete;
+
+    // Forgets every frame and caches `text` at the font's current size from now on, one
+    // frame per `step_degrees` (clamped so there are at most kMaxRotatedFrames), centred on
+    // (centre_x, centre_y) of the target
+    void reset(FontRenderer& font,
+               std::string_view text,
+               int step_degrees,
+               int centre_x,
+               int centre_y) noexcept;
+
+    // Replaces the whole of `target` with the text rotated clockwise by `degrees`, rounded
+    // down to a multiple of the step. `target` must be the same size on every call.
+    void draw(FontRenderer& font, const PageBitmap& target, int degrees) noexcept;
+
+    int step_degrees() const noexcept
+    {
+        return m_step;
+    }
+
+    RotatedTextStats stats() const noexcept
+    {
+        return m_stats;
+    }
+
+  private:
+    // Page-aligned box of a stored frame; everything outside it is blank
+    struct Frame
+    {
+        std::uint32_t offset; // into m_storage
+        std::uint8_t x;       // targets are at most 255 px wide
+        std::uint8_t page;
+        std::uint8_t width;
+        std::uint8_t pages;
+        bool valid;
+    };
+
+    void render(FontRenderer& font, const PageBitmap& target, int degrees) const noexcept;
+    void store(const PageBitmap& target, Frame& frame) noexcept;
+
+    std::span<std::uint8_t> m_storage;
+    std::array<Frame, kMaxRotatedFrames> m_frames{};
+    TextLayout m_layout;
+    int m_step = 0;
+    int m_centre_x = 0;
+    int m_centre_y = 0;
+    RotatedTextStats m_stats{};
+};
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_ROTATED_TEXT_CACHE_H
@@ -0,0 +1,190 @@
+#ifndef COMPONENTS_FONTS_TEXT_LAYOUT_H
+#define COMPONENTS_FONTS_TEXT_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "FontMetrics.h"
+#include "Utf8.h"
+
+namespace muc::fonts
+{
+
+// Capacity of one layout, and how many layouts a TextLayoutCache keeps. Text beyond
+// kMaxLayoutGlyphs is cut off; text longer than kMaxLayoutKeyBytes is laid out on every
+// request instead of being cached.
+constexpr std::size_t kMaxLayoutGlyphs = 64;
+constexpr std::size_t kMaxLayoutKeyBytes = 128;
+constexpr std::size_t kTextLayoutSlots = 4;
+
+// One placed glyph. (x, y) is its pen position relative to the layout origin, the pen
+// position on the first baseline; y grows downwards, one line_height per line. The ink
+// box is kept so the layout can be measured after lines have been rewrapped.
+struct LayoutGlyph
+{
+    std::uint32_t codepoint;
+    std::int16_t x;
+    std::int16_t y;
+    std::int8_t left;
+    std::int8_t top;
+    std::uint8_t width;
+    std::uint8_t rows;
+};
+
+// Smallest box around every set pixel, relative to the layout origin (right and bottom
+// exclusive). All zero for text without ink.
+struct TextBounds
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+// Glyph positions of a text, computed from metrics and kerning only; drawing it is left
+// to draw_layout(). Filled by layout_text().
+class TextLayout
+{
+  public:
+    std::span<const LayoutGlyph> glyphs() const noexcept
+    {
+        return std::span<const LayoutGlyph>(m_glyphs.data(), m_count);
+    }
+
+    TextBounds bounds() const noexcept
+    {
+        return m_bounds;
+    }
+
+    int lines() const noexcept
+    {
+        return m_line + 1;
+    }
+
+    // True if the text did not fit kMaxLayoutGlyphs
+    bool truncated() const noexcept
+    {
+        return m_truncated;
+    }
+
+    // Building, see layout_text(). A glyph whose ink would cross `max_width` moves to a
+    // new line together with the rest of its word; words wider than a line break between
+    // characters. 0 disables wrapping.
+    void reset(int line_height, int max_width) noexcept;
+    bool append(std::uint32_t codepoint, const GlyphMetrics& metrics, int kerning) noexcept;
+    void new_line() noexcept;
+    void finish() noexcept;
+
+  private:
+    // Starts a new line, taking the glyphs after the last space along; false if there were
+    // none to take
+    bool wrap() noexcept;
+
+    std::array<LayoutGlyph, kMaxLayoutGlyphs> m_glyphs{};
+    std::size_t m_count = 0;
+    std::size_t m_line_start = 0; // first glyph of the current line
+    std::size_t m_break = 0;      // first glyph after the last space of the current line
+    int m_line = 0;
+    int m_pen_x = 0;
+    int m_line_height = 0;
+    int m_max_width = 0;
+    bool m_truncated = false;
+    TextBounds m_bounds{};
+};
+
+// Lays out UTF-8 `text` into `layout`, breaking lines at '\n' and wrapping them to
+// `max_width` pixels. `Font` is an AtlasFont or a FontRenderer: anything with
+// metrics(), kerning() and font_metrics(). Nothing is rasterized.
+template <typename Font>
+void layout_text(Font& font, std::string_view text, int max_width, TextLayout& layout) noexcept
+{
+    layout.reset(font.font_metrics().line_height, max_width);
+
+    std::uint32_t previous = 0;
+    for (std::uint32_t codepoint : Utf8Range(text))
+    {
+        if (codepoint == '\n')
+        {
+            layout.new_line();
+            previous = 0;
+            continue;
+        }
+
+        const int kerning = previous ? font.kerning(previous, codepoint) : 0;
+        if (!layout.append(codepoint, font.metrics(codepoint), kerning))
+        {
+            break;
+        }
+        previous = codepoint;
+    }
+    layout.finish();
+}
+
+struct TextLayoutCacheStats
+{
+    std::uint32_t hits;
+    std::uint32_t misses;
+};
+
+// The last few layouts of one font, keyed by (text, pixel size, max width), so redrawing
+// unchanged text costs a lookup instead of a layout. Not thread-safe.
+class TextLayoutCache
+{
+  public:
+    TextLayoutCache() noexcept = default;
+
+    TextLayoutCache(const TextLayoutCache&) = delete;
+    TextLayoutCache& operator=(const TextLayoutCache&) = delete;
+
+    // Layout of `text` in `font`, laid out on the first request. Valid until the next
+    // layout() call.
+    template <typename Font>
+    const TextLayout& layout(Font& font, std::string_view text, int max_width) noexcept
+    {
+        const int pixel_size = font.font_metrics().pixel_size;
+        if (const TextLayout* cached = find(text, pixel_size, max_width))
+        {
+            return *cached;
+        }
+
+        TextLayout& fresh = claim(text, pixel_size, max_width);
+        layout_text(font, text, max_width, fresh);
+        return fresh;
+    }
+
+    void clear() noexcept;
+
+    TextLayoutCacheStats stats() const noexcept
+    {
+        return m_stats;
+    }
+
+  private:
+    struct Slot
+    {
+        TextLayout layout;
+        std::array<char, kMaxLayoutKeyBytes> text;
+        std::uint8_t text_size;
+        std::uint8_t pixel_size;
+        std::int16_t max_width;
+        std::uint32_t last_used; // m_clock at the last find()/claim()
+        bool valid;
+    };
+
+    // Cached layout or nullptr; counts a hit or a miss
+    const TextLayout* find(std::string_view text, int pixel_size, int max_width) noexcept;
+
+    // Least recently used slot, keyed to `text` if it is short enough to be compared later
+    TextLayout& claim(std::string_view text, int pixel_size, int max_width) noexcept;
+
+    std::array<Slot, kTextLayoutSlots> m_slots{};
+    std::uint32_t m_clock = 0;
+    TextLayoutCacheStats m_stats{};
+};
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_TEXT_LAYOUT_H
@@ -0,0 +1,61 @@
+#ifndef COMPONENTS_FONTS_TEXT_RENDERER_H
+#define COMPONENTS_FONTS_TEXT_RENDERER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "PackedGlyph.h"
+#include "PageBitmap.h"
+#include "TextLayout.h"
+#include "Utf8.h"
+#include "ssd1306.h"
+
+namespace muc::fonts
+{
+
+// Draws `glyph` with its origin (pen position on the baseline) at (x, y)
+void draw_glyph(const PageBitmap& target, const PackedGlyph& glyph, int x, int y) noexcept;
+
+inline void draw_glyph(ssd1306::Oled& oled, const PackedGlyph& glyph, int x, int y) noexcept
+{
+    draw_glyph(page_bitmap(oled), glyph, x, y);
+}
+
+// Draws UTF-8 `text` as one kerned line from pen position x on baseline y and returns the
+// pen position after the last glyph. `Target` is an Oled or a PageBitmap, `Font` an
+// AtlasFont or a FontRenderer.
+template <typename Target, typename Font>
+int draw_text(Target& target, Font& font, int x, int y, std::string_view text) noexcept
+{
+    std::uint32_t previous = 0;
+    for (std::uint32_t codepoint : Utf8Range(text))
+    {
+        const PackedGlyph* glyph = font.glyph(codepoint);
+        if (glyph)
+        {
+            x += previous ? font.kerning(previous, codepoint) : 0;
+            draw_glyph(target, *glyph, x, y);
+            x += glyph->advance;
+            previous = codepoint;
+        }
+    }
+    return x;
+}
+
+// Draws a layout of `font` with its origin (pen position on the first baseline) at (x, y)
+template <typename Target, typename Font>
+void draw_layout(Target& target, Font& font, const TextLayout& layout, int x, int y) noexcept
+{
+    for (const LayoutGlyph& placed : layout.glyphs())
+    {
+        const PackedGlyph* glyph = font.glyph(placed.codepoint);
+        if (glyph)
+        {
+            draw_glyph(target, *glyph, x + placed.x, y + placed.y);
+        }
+    }
+}
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_TEXT_RENDERER_H
@@ -0,0 +1,173 @@
+#ifndef COMPONENTS_FONTS_UTF8_H
+#define COMPONENTS_FONTS_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+
+namespace muc::fonts
+{
+
+// Stands in for every malformed sequence
+constexpr std::uint32_t kReplacementChar = 0xFFFD;
+
+// Decodes the code point at the front of `text` (which must not be empty) and removes it.
+//
+// Never reads past `text`. Malformed input - stray continuation bytes, overlong forms,
+// surrogates, values above U+10FFFF, truncated sequences - yields kReplacementChar and
+// consumes the longest prefix that could have started a valid sequence (at least one
+// byte), the "maximal subpart" practice of the Unicode standard.
+std::uint32_t decode_utf8_sequence(std::string_view& text) noexcept;
+
+// decode_utf8_sequence() with ASCII handled inline
+inline std::uint32_t decode_utf8(std::string_view& text) noexcept
+{
+    const auto lead = static_cast<std::uint8_t>(text.front());
+    if (lead < 0x80)
+    {
+        text.remove_prefix(1);
+        return lead;
+    }
+    return decode_utf8_sequence(text);
+}
+
+// Number of leading ASCII bytes in `text`, scanned a machine word at a time
+std::size_t ascii_prefix(std::string_view text) noexcept;
+
+// Decodes `text` into `out` until either runs out; returns the number of code points
+// written. ASCII runs are found a word at a time and copied without per-byte decoding.
+std::size_t decode_utf8(std::string_view text, std::span<std::uint32_t> out) noexcept;
+
+// Number of code points decode_utf8() yields for `text`
+std::size_t utf8_length(std::string_view text) noexcept;
+
+// Forward iterator over the code points of a UTF-8 string (see Utf8Range)
+class Utf8Iterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::uint32_t;
+
+    Utf8Iterator() noexcept = default;
+
+    explicit Utf8Iterator(std::string_view text) noexcept
+    : m_begin(text.data())
+    , m_next(text.data())
+    , m_end(text.data() + text.size())
+    , m_ascii_end(text.data())
+    {
+        advance();
+    }
+
+    std::uint32_t operator*() const noexcept
+    {
+        return m_codepoint;
+    }
+
+    Utf8Iterator& operator++() noexcept
+    {
+        advance();
+        return *this;
+    }
+
+    Utf8Iterator operator++(int) noexcept
+    {
+        Utf8Iterator previous = *this;
+        advance();
+        return previous;
+    }
+
+    // Byte range of the current code point within the iterated string, e.g. to break
+    // lines or to cache a layout
+    std::size_t offset() const noexcept
+    {
+        return static_cast<std::size_t>(m_current - m_begin);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>(m_next - m_current);
+    }
+
+    bool operator==(const Utf8Iterator& other) const noexcept
+    {
+        return m_current == other.m_current;
+    }
+
+    bool operator==(std::default_sentinel_t) const noexcept
+    {
+        return m_current == m_end;
+    }
+
+  private:
+    void advance() noexcept
+    {
+        m_current = m_next;
+        if (m_current == m_end)
+        {
+            return;
+        }
+
+        // Inside a known ASCII run the byte is the code point. A run is measured a word at a
+        // time when it starts, so the bytes after its first one skip all checks.
+        const auto lead = static_cast<std::uint8_t>(*m_current);
+        if (m_current < m_ascii_end || lead < 0x80)
+        {
+            if (m_current >= m_ascii_end)
+            {
+                m_ascii_end = m_current + ascii_prefix(rest());
+            }
+            m_codepoint = lead;
+            m_next = m_current + 1;
+            return;
+        }
+
+        std::string_view sequence = rest();
+        m_codepoint = decode_utf8_sequence(sequence);
+        m_next = sequence.data();
+    }
+
+    std::string_view rest() const noexcept
+    {
+        return std::string_view(m_current, static_cast<std::size_t>(m_end - m_current));
+    }
+
+    const char* m_begin = nullptr;
+    const char* m_current = nullptr;
+    const char* m_next = nullptr;
+    const char* m_end = nullptr;
+    const char* m_ascii_end = nullptr;
+    std::uint32_t m_codepoint = 0;
+};
+
+// Code points of a UTF-8 string: for (std::uint32_t cp : Utf8Range(text)) ...
+class Utf8Range
+{
+  public:
+    explicit Utf8Range(std::string_view text) noexcept
+    : m_text(text)
+    {
+    }
+
+    Utf8Iterator begin() const noexcept
+    {
+        return Utf8Iterator(m_text);
+    }
+
+    std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+  private:
+    std::string_view m_text;
+};
+
+} // namespace muc::fonts
+
+#endif // COMPONENTS_FONTS_UTF8_H
@@ -0,0 +1,267 @@
+#include "Affine.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace muc::fonts
+{
+
+namespace
+{
+// sin(0..90 degrees) * 65536, rounded
+constexpr std::array<std::int32_t, 91> kQuarterSine = {
+    0, 1144, 2287, 3430, 4572, 5712, 6850, 7987, 9121, 10252, 11380, 12505, 13626, 14742, 15855,
+    16962, 18064, 19161, 20252, 21336, 22415, 23486, 24550, 25607, 26656, 27697, 28729, 29753,
+    30767, 31772, 32768, 33754, 34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243, 42126,
+    42995, 43852, 44695, 45525, 46341, 47143, 47930, 48703, 49461, 50203, 50931, 51643, 52339,
+    53020, 53684, 54332, 54963, 55578, 56175, 56756, 57319, 57865, 58393, 58903, 59396, 59870,
+    60326, 60764, 61183, 61584, 61966, 62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+    64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446, 65496, 65526, 65536,
+};
+
+// Product of two Q16.16 values
+std::int32_t mul(std::int32_t a, std::int32_t b) noexcept
+{
+    return static_cast<std::int32_t>((static_cast<std::int64_t>(a) * b) >> 16);
+}
+
+// Whole pixel containing a Q16.16 coordinate
+int floor_pixel(std::int64_t value) noexcept
+{
+    return static_cast<int>(value >> 16);
+}
+
+int ceil_pixel(std::int64_t value) noexcept
+{
+    return static_cast<int>((value + kFixedOne - 1) >> 16);
+}
+
+std::int32_t floor_div(std::int32_t a, std::int32_t b) noexcept
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Narrows [begin, end) to the steps k where 0 <= start + k * step < limit
+void clip_span(std::int32_t start,
+               std::int32_t step,
+               std::int32_t limit,
+               int& begin,
+               int& end) noexcept
+{
+    std::int32_t first = 0;
+    std::int32_t last = 0;
+    if (step > 0)
+    {
+        first = -floor_div(start, step);
+        last = -floor_div(start - limit, step);
+    }
+    else if (step < 0)
+    {
+        first = floor_div(start - limit, -step) + 1;
+        last = floor_div(start, -step) + 1;
+    }
+    else if (start < 0 || start >= limit)
+    {
+        end = begin;
+        return;
+    }
+    else
+    {
+        return;
+    }
+    begin = std::max(begin, static_cast<int>(first));
+    end = std::min(end, static_cast<int>(last));
+}
+} // namespace
+
+std::int32_t sin_fixed(int degrees) noexcept
+{
+    int d = degrees % 360;
+    if (d < 0)
+    {
+        d += 360;
+    }
+
+    if (d <= 90)
+    {
+        return kQuarterSine[d];
+    }
+    if (d <= 180)
+    {
+        return kQuarterSine[180 - d];
+    }
+    if (d <= 270)
+    {
+        return -kQuarterSine[d - 180];
+    }
+    return -kQuarterSine[360 - d];
+}
+
+std::int32_t cos_fixed(int degrees) noexcept
+{
+    return sin_fixed(degrees % 360 + 90);
+}
+
+Affine Affine::identity() noexcept
+{
+    return Affine{.xx = kFixedOne, .xy = 0, .tx = 0, .yx = 0, .yy = kFixedOne, .ty = 0};
+}
+
+Affine Affine::translation(std::int32_t x, std::int32_t y) noexcept
+{
+    return Affine{.xx = kFixedOne, .xy = 0, .tx = x, .yx = 0, .yy = kFixedOne, .ty = y};
+}
+
+Affine Affine::rotation(int degrees) noexcept
+{
+    const std::int32_t c = cos_fixed(degrees);
+    const std::int32_t s = sin_fixed(degrees);
+    return Affine{.xx = c, .xy = -s, .tx = 0, .yx = s, .yy = c, .ty = 0};
+}
+
+Affine Affine::scaling(std::int32_t x, std::int32_t y) noexcept
+{
+    return Affine{.xx = x, .xy = 0, .tx = 0, .yx = 0, .yy = y, .ty = 0};
+}
+
+Affine Affine::shearing(std::int32_t x_per_y, std::int32_t y_per_x) noexcept
+{
+    return Affine{.xx = kFixedOne, .xy = x_per_y, .tx = 0, .yx = y_per_x, .yy = kFixedOne, .ty = 0};
+}
+
+Affine Affine::operator*(const Affine& rhs) const noexcept
+{
+    return Affine{.xx = mul(xx, rhs.xx) + mul(xy, rhs.yx),
+                  .xy = mul(xx, rhs.xy) + mul(xy, rhs.yy),
+                  .tx = mul(xx, rhs.tx) + mul(xy, rhs.ty) + tx,
+                  .yx = mul(yx, rhs.xx) + mul(yy, rhs.yx),
+                  .yy = mul(yx, rhs.xy) + mul(yy, rhs.yy),
+                  .ty = mul(yx, rhs.tx) + mul(yy, rhs.ty) + ty};
+}
+
+bool Affine::invert(Affine& out) const noexcept
+{
+    // Determinant in Q32.32; the inverse matrix is the adjugate divided by it
+    const std::int64_t det =
+        static_cast<std::int64_t>(xx) * yy - static_cast<std::int64_t>(xy) * yx;
+    if (det == 0)
+    {
+        return false;
+    }
+
+    // A near-singular map has an inverse beyond Q16.16; refuse it rather than wrap
+    constexpr std::int64_t kMax = std::numeric_limits<std::int32_t>::max();
+    bool fits = true;
+    const auto divide = [det, &fits](std::int32_t value, bool negate)
+    {
+        const std::int64_t quotient =
+            static_cast<std::int64_t>(value) * (std::int64_t{1} << 32) / det;
+        if (quotient < -kMax || quotient > kMax)
+        {
+            fits = false;
+            return std::int32_t{0};
+        }
+        return static_cast<std::int32_t>(negate ? -quotient : quotient);
+    };
+    const auto translate = [&fits](std::int32_t a, std::int32_t x, std::int32_t b, std::int32_t y)
+    {
+        const std::int64_t sum = -((static_cast<std::int64_t>(a) * x) >> 16) -
+                                 ((static_cast<std::int64_t>(b) * y) >> 16);
+        if (sum < -kMax || sum > kMax)
+        {
+            fits = false;
+            return std::int32_t{0};
+        }
+        return static_cast<std::int32_t>(sum);
+    };
+
+    Affine inverse{};
+    inverse.xx = divide(yy, false);
+    inverse.xy = divide(xy, true);
+    inverse.yx = divide(yx, true);
+    inverse.yy = divide(xx, false);
+    inverse.tx = translate(inverse.xx, tx, inverse.xy, ty);
+    inverse.ty = translate(inverse.yx, tx, inverse.yy, ty);
+    if (!fits)
+    {
+        return false;
+    }
+    out = inverse;
+    return true;
+}
+
+void blit_affine(const PageBitmap& target,
+                 const PageBitmap& source,
+                 const Affine& to_target) noexcept
+{
+    Affine to_source;
+    if (source.width <= 0 || source.height <= 0 || !to_target.invert(to_source))
+    {
+        return;
+    }
+
+    // Target pixels the mapped source rectangle can touch, clipped to the target
+    std::int64_t min_x = std::numeric_limits<std::int64_t>::max();
+    std::int64_t min_y = min_x;
+    std::int64_t max_x = std::numeric_limits<std::int64_t>::min();
+    std::int64_t max_y = max_x;
+    for (const int cy : {0, source.height})
+    {
+        for (const int cx : {0, source.width})
+        {
+            const std::int64_t x = static_cast<std::int64_t>(to_target.xx) * cx +
+                                   static_cast<std::int64_t>(to_target.xy) * cy + to_target.tx;
+            const std::int64_t y = static_cast<std::int64_t>(to_target.yx) * cx +
+                                   static_cast<std::int64_t>(to_target.yy) * cy + to_target.ty;
+            min_x = std::min(min_x, x);
+            max_x = std::max(max_x, x);
+            min_y = std::min(min_y, y);
+            max_y = std::max(max_y, y);
+        }
+    }
+    const int x_begin = std::max(floor_pixel(min_x), 0);
+    const int x_end = std::min(ceil_pixel(max_x), target.width);
+    const int y_begin = std::max(floor_pixel(min_y), 0);
+    const int y_end = std::min(ceil_pixel(max_y), target.height);
+
+    const std::int32_t source_width = to_fixed(source.width);
+    const std::int32_t source_height = to_fixed(source.height);
+    for (int y = y_begin; y < y_end; ++y)
+    {
+        // Source position of the centre of target pixel (x_begin, y); each step right adds
+        // one column of the inverse matrix
+        const std::int32_t cx = to_fixed(x_begin) + kFixedOne / 2;
+        const std::int32_t cy = to_fixed(y) + kFixedOne / 2;
+        std::int32_t sx = mul(to_source.xx, cx) + mul(to_source.xy, cy) + to_source.tx;
+        std::int32_t sy = mul(to_source.yx, cx) + mul(to_source.yy, cy) + to_source.ty;
+
+        // Only the run of the row that lands inside the source is walked, so the loop needs
+        // no bounds checks
+        int begin = 0;
+        int end = x_end - x_begin;
+        clip_span(sx, to_source.xx, source_width, begin, end);
+        clip_span(sy, to_source.yx, source_height, begin, end);
+        if (begin >= end)
+        {
+            continue;
+        }
+        sx += begin * to_source.xx;
+        sy += begin * to_source.yx;
+
+        // Branch-free: which source pixels are set follows no pattern a predictor could learn
+        std::uint8_t* row = target.data + (y >> 3) * target.width;
+        const int shift = y & 7;
+        for (int x = x_begin + begin; x < x_begin + end; ++x)
+        {
+            const int ix = sx >> 16;
+            const int iy = sy >> 16;
+            const unsigned set = (source.data[(iy >> 3) * source.width + ix] >> (iy & 7)) & 1u;
+            row[x] |= static_cast<std::uint8_t>(set << shift);
+            sx += to_source.xx;
+            sy += to_source.yx;
+        }
+    }
+}
+
+} // namespace muc::fonts
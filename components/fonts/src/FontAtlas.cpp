@@ -0,0 +1,53 @@
+#include "FontAtlas.h"
+
+#include <algorithm>
+
+namespace muc::fonts
+{
+
+const PackedGlyph* AtlasFont::glyph(std::uint32_t codepoint) const noexcept
+{
+    const auto it = std::lower_bound(codepoints.begin(), codepoints.end(), codepoint);
+    if (it == codepoints.end() || *it != codepoint)
+    {
+        return &fallback;
+    }
+    return &glyphs[static_cast<std::size_t>(it - codepoints.begin())];
+}
+
+GlyphMetrics AtlasFont::metrics(std::uint32_t codepoint) const noexcept
+{
+    const PackedGlyph& g = *glyph(codepoint);
+    return GlyphMetrics{.width = g.width,
+                        .rows = g.rows,
+                        .left = g.left,
+                        .top = g.top,
+                        .advance = g.advance};
+}
+
+int AtlasFont::kerning(std::uint32_t left, std::uint32_t right) const noexcept
+{
+    const auto before = [](const KerningPair& a, const KerningPair& b)
+    { return a.left != b.left ? a.left < b.left : a.right < b.right; };
+    const KerningPair key{.left = left, .right = right, .x = 0};
+    const auto it = std::lower_bound(kerning_pairs.begin(), kerning_pairs.end(), key, before);
+    if (it == kerning_pairs.end() || it->left != left || it->right != right)
+    {
+        return 0;
+    }
+    return it->x;
+}
+
+const AtlasFont* find_atlas_font(int pixel_size) noexcept
+{
+    for (const AtlasFont* font : atlas_fonts())
+    {
+        if (font->pixel_size == pixel_size)
+        {
+            return font;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace muc::fonts
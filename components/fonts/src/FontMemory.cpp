@@ -0,0 +1,214 @@
+#include "FontMemory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+
+#include <esp_log.h>
+#include <sdkconfig.h>
+
+namespace muc::fonts
+{
+
+namespace
+{
+constexpr const char* TAG = "FontMemory";
+
+// Every block starts with a header; payloads stay 8-byte aligned
+struct Header
+{
+    std::uint32_t size; // whole block, header included
+    std::uint32_t used;
+};
+
+constexpr std::size_t kAlign = 8;
+constexpr std::size_t kHeaderBytes = sizeof(Header);
+constexpr std::size_t kMinBlockBytes = kHeaderBytes + kAlign;
+constexpr std::size_t kArenaBytes = CONFIG_FONTS_FREETYPE_ARENA_BYTES / kAlign * kAlign;
+
+static_assert(kHeaderBytes % kAlign == 0);
+
+alignas(kAlign) std::array<std::uint8_t, kArenaBytes> s_arena;
+std::mutex s_mutex;
+bool s_initialized = false;
+FontMemoryStats s_stats{};
+
+Header* header_at(std::size_t offset)
+{
+    return reinterpret_cast<Header*>(s_arena.data() + offset);
+}
+
+Header* header_of(void* block)
+{
+    return reinterpret_cast<Header*>(static_cast<std::uint8_t*>(block) - kHeaderBytes);
+}
+
+std::size_t offset_of(const Header* header)
+{
+    return static_cast<std::size_t>(reinterpret_cast<const std::uint8_t*>(header) -
+                                    s_arena.data());
+}
+
+std::size_t block_bytes(long size)
+{
+    return (static_cast<std::size_t>(size) + kHeaderBytes + kAlign - 1) / kAlign * kAlign;
+}
+
+void init_locked()
+{
+    if (!s_initialized)
+    {
+        *header_at(0) = Header{.size = static_cast<std::uint32_t>(kArenaBytes), .used = 0};
+        s_stats.total_bytes = kArenaBytes;
+        s_initialized = true;
+    }
+}
+
+// Merges the free blocks following `header` into it
+void coalesce(Header* header)
+{
+    std::size_t next = offset_of(header) + header->size;
+    while (next < kArenaBytes && !header_at(next)->used)
+    {
+        header->size += header_at(next)->size;
+        next = offset_of(header) + header->size;
+    }
+}
+
+// Marks `header` used with `bytes`, splitting off the rest as a free block if it is large
+// enough to hold one
+void take(Header* header, std::size_t bytes)
+{
+    if (header->size - bytes >= kMinBlockBytes)
+    {
+        *header_at(offset_of(header) + bytes) =
+            Header{.size = static_cast<std::uint32_t>(header->size - bytes), .used = 0};
+        header->size = static_cast<std::uint32_t>(bytes);
+    }
+    header->used = 1;
+}
+
+void* alloc_locked(long size)
+{
+    init_locked();
+
+    const std::size_t bytes = block_bytes(size);
+    for (std::size_t offset = 0; offset < kArenaBytes; offset += header_at(offset)->size)
+    {
+        // First fit; neighbouring free blocks are merged on the way
+        Header* header = header_at(offset);
+        if (header->used)
+        {
+            continue;
+        }
+        coalesce(header);
+        if (header->size >= bytes)
+        {
+            take(header, bytes);
+            s_stats.used_bytes += header->size;
+            s_stats.peak_bytes = std::max(s_stats.peak_bytes, s_stats.used_bytes);
+            s_stats.allocations++;
+            return reinterpret_cast<std::uint8_t*>(header) + kHeaderBytes;
+        }
+    }
+
+    s_stats.failed++;
+    ESP_LOGE(TAG,
+             "FreeType arena exhausted: %ld bytes requested, %lu of %lu in use",
+             size,
+             static_cast<unsigned long>(s_stats.used_bytes),
+             static_cast<unsigned long>(kArenaBytes));
+    return nullptr;
+}
+
+void free_locked(void* block)
+{
+    Header* header = header_of(block);
+    header->used = 0;
+    s_stats.used_bytes -= header->size;
+    s_stats.allocations--;
+    coalesce(header);
+}
+
+void* ft_alloc(FT_Memory, long size)
+{
+    if (size <= 0)
+    {
+        return nullptr;
+    }
+    std::lock_guard lock(s_mutex);
+    return alloc_locked(size);
+}
+
+void ft_free(FT_Memory, void* block)
+{
+    if (!block)
+    {
+        return;
+    }
+    std::lock_guard lock(s_mutex);
+    free_locked(block);
+}
+
+void* ft_realloc(FT_Memory, long cur_size, long new_size, void* block)
+{
+    std::lock_guard lock(s_mutex);
+    if (!block)
+    {
+        return alloc_locked(new_size);
+    }
+
+    // Shrink or grow in place when the block (plus a free successor) is large enough
+    Header* header = header_of(block);
+    const std::size_t bytes = block_bytes(new_size);
+    const std::uint32_t old_bytes = header->size;
+    header->used = 0;
+    coalesce(header);
+    if (header->size >= bytes)
+    {
+        take(header, bytes);
+        s_stats.used_bytes = s_stats.used_bytes - old_bytes + header->size;
+        s_stats.peak_bytes = std::max(s_stats.peak_bytes, s_stats.used_bytes);
+        return block;
+    }
+    take(header, old_bytes);
+
+    void* moved = alloc_locked(new_size);
+    if (moved)
+    {
+        std::memcpy(moved, block, static_cast<std::size_t>(std::min(cur_size, new_size)));
+        free_locked(block);
+    }
+    return moved;
+}
+
+FT_MemoryRec_ s_memory{.user = nullptr,
+                       .alloc = ft_alloc,
+                       .free = ft_free,
+                       .realloc = ft_realloc};
+} // namespace
+
+FT_Memory font_memory() noexcept
+{
+    return &s_memory;
+}
+
+FontMemoryStats font_memory_stats() noexcept
+{
+    std::lock_guard lock(s_mutex);
+    init_locked();
+
+    FontMemoryStats stats = s_stats;
+    std::uint32_t run = 0;
+    for (std::size_t offset = 0; offset < kArenaBytes; offset += header_at(offset)->size)
+    {
+        const Header* header = header_at(offset);
+        run = header->used ? 0 : run + header->size;
+        stats.largest_free_block = std::max(stats.largest_free_block, run);
+    }
+    return stats;
+}
+
+} // namespace muc::fonts
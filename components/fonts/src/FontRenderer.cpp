@@ -1,71 +1,192 @@
 #include "FontRenderer.h"
 
+#include FT_MODULE_H
+#include FT_OUTLINE_H
+
+#include <sdkconfig.h>
+
+#include "FontMemory.h"
+
 namespace muc::fonts
 {
 
+namespace
+{
+constexpr RasterOptions kConfiguredRaster{
+#if CONFIG_FONTS_RASTER_MONO
+    .mode = RasterMode::Mono,
+#elif CONFIG_FONTS_RASTER_DITHER
+    .mode = RasterMode::Dither,
+#else
+    .mode = RasterMode::Threshold,
+#endif
+#ifdef CONFIG_FONTS_RASTER_COVERAGE_THRESHOLD
+    .threshold = CONFIG_FONTS_RASTER_COVERAGE_THRESHOLD,
+#else
+    .threshold = kCoverageThreshold,
+#endif
+};
+
+// Pixel range [min, max) FreeType's 1-bit rasterizer gives an outline spanning
+// [low, high] (26.6) along one axis: the pixels whose centres it covers, and at least one
+// (ft_glyphslot_preset_bitmap() in ftobjs.c)
+void mono_span(FT_Pos low, FT_Pos high, FT_Pos& min, FT_Pos& max) noexcept
+{
+    min = (low + 31) >> 6;
+    max = (high + 32) >> 6;
+    if (min == max)
+    {
+        if (((low + 31) & 63) - 31 + ((high + 32) & 63) - 32 < 0)
+        {
+            min -= 1;
+        }
+        else
+        {
+            max += 1;
+        }
+    }
+}
+} // namespace
+
 FontRenderer::FontRenderer() noexcept
 : library{}
 , face{}
+, m_raster{kConfiguredRaster}
 {
     // blank
 }
 
-std::uint32_t decode_utf8(const char*& p) noexcept
+bool FontRenderer::init(const std::uint8_t* data, std::size_t size, int pixel_size) noexcept
 {
-    // Fetch the first byte and advance the pointer
-    std::uint8_t c = static_cast<std::uint8_t>(*p++);
+    // FT_Init_FreeType() would allocate from the general heap
+    if (FT_New_Library(font_memory(), &library))
+    {
+        return false;
+    }
+    FT_Add_Default_Modules(library);
+    FT_Set_Default_Properties(library);
 
-    // --- 1-BYTE SEQUENCE (Standard ASCII) ---
-    // Range: U+0000 to U+007F
-    // Bit pattern: 0xxxxxxx
-    if (c < 0x80)
+    if (FT_New_Memory_Face(library, data, static_cast<FT_Long>(size), 0, &face))
     {
-        return c;
+        return false;
     }
+    FT_Set_Pixel_Sizes(face, 0, pixel_size);
+    m_pixel_size = pixel_size;
+    return true;
+}
 
-    // --- 2-BYTE SEQUENCE (e.g., £, ©, or German Umlauts like 'ü') ---
-    // Range: U+0080 to U+07FF
-    // Bit pattern: 110xxxxx 10xxxxxx
-    // (c & 0xE0) == 0xC0 checks if the first 3 bits are '110'
-    if ((c & 0xE0) == 0xC0)
+void FontRenderer::set_pixel_size(int pixel_size) noexcept
+{
+    if (pixel_size == m_pixel_size)
+    {
+        return;
+    }
+    m_pixel_size = pixel_size;
+    if (face)
     {
-        // (c & 0x1F): Keeps the 5 data bits from the first byte
-        // << 6: Shifts them to the high position
-        // (*p++ & 0x3F): Takes 6 data bits from the next byte (ignores the '10' prefix)
-        return ((c & 0x1F) << 6) | (static_cast<std::uint8_t>(*p++) & 0x3F);
+        FT_Set_Pixel_Sizes(face, 0, pixel_size);
     }
+}
 
-    // --- 3-BYTE SEQUENCE (e.g., Euro sign '€' or Basic Multilingual Plane) ---
-    // Range: U+0800 to U+FFFF
-    // Bit pattern: 1110xxxx 10xxxxxx 10xxxxxx
-    // (c & 0xF0) == 0xE0 checks if the first 4 bits are '1110'
-    if ((c & 0xF0) == 0xE0)
+void FontRenderer::set_raster_options(const RasterOptions& options) noexcept
+{
+    m_raster = options;
+    m_cache.clear();
+}
+
+const PackedGlyph* FontRenderer::glyph(std::uint32_t codepoint) noexcept
+{
+    if (const PackedGlyph* cached = m_cache.find(codepoint, m_pixel_size))
     {
-        std::uint8_t c2 = static_cast<std::uint8_t>(*p++);
-        std::uint8_t c3 = static_cast<std::uint8_t>(*p++);
+        return cached;
+    }
 
-        // (c & 0x0F): Keeps 4 data bits from 1st byte (shfited 12)
-        // (c2 & 0x3F): Keeps 6 data bits from 2nd byte (shifted 6)
-        // (c3 & 0x3F): Keeps 6 data bits from 3rd byte
-        return ((c & 0x0F) << 12) | ((c2 & 0x3F) << 6) | (c3 & 0x3F);
+    if (!face || FT_Load_Char(face, codepoint, raster_load_flags(m_raster.mode)))
+    {
+        return nullptr;
     }
 
-    // Fallback for 4-byte sequences (Emoji/Ancient scripts) or invalid UTF-8
-    return '?';
+    const FT_GlyphSlot slot = face->glyph;
+    const FT_Bitmap& source = slot->bitmap;
+    std::uint8_t* columns = nullptr;
+    PackedGlyph* cached = m_cache.allocate(codepoint,
+                                           m_pixel_size,
+                                           static_cast<int>(source.width),
+                                           static_cast<int>(source.rows),
+                                           columns);
+    cached->left = static_cast<std::int8_t>(slot->bitmap_left);
+    cached->top = static_cast<std::int8_t>(slot->bitmap_top);
+    cached->advance = static_cast<std::int16_t>(slot->advance.x >> 6);
+    // Columns and rows beyond a cache slot are dropped: only the clipped box is packed,
+    // with its own width as the page stride
+    FT_Bitmap visible = source;
+    visible.width = static_cast<unsigned>(cached->width);
+    visible.rows = static_cast<unsigned>(cached->rows);
+    pack_bitmap(visible, m_raster, columns);
+    return cached;
 }
 
-bool FontRenderer::init(const std::uint8_t* data, std::size_t size, int pixel_size) noexcept
+GlyphMetrics FontRenderer::metrics(std::uint32_t codepoint) noexcept
 {
-    if (FT_Init_FreeType(&library))
+    // A hinted load grid-fits the metrics to exactly the box FT_LOAD_RENDER would produce
+    if (!face || FT_Load_Char(face, codepoint, raster_load_flags(m_raster.mode, false)))
     {
-        return false;
+        return GlyphMetrics{};
     }
-    if (FT_New_Memory_Face(library, data, static_cast<FT_Long>(size), 0, &face))
+
+    const FT_GlyphSlot slot = face->glyph;
+    if (m_raster.mode == RasterMode::Mono && slot->format == FT_GLYPH_FORMAT_OUTLINE)
     {
-        return false;
+        // The 1-bit rasterizer only keeps pixels whose centres the outline covers, so its
+        // box can be smaller than the grid-fitted metrics
+        FT_BBox cbox;
+        FT_Outline_Get_CBox(&slot->outline, &cbox);
+        FT_Pos left = 0;
+        FT_Pos right = 0;
+        FT_Pos bottom = 0;
+        FT_Pos top = 0;
+        mono_span(cbox.xMin, cbox.xMax, left, right);
+        mono_span(cbox.yMin, cbox.yMax, bottom, top);
+        return GlyphMetrics{.width = static_cast<int>(right - left),
+                            .rows = static_cast<int>(top - bottom),
+                            .left = static_cast<int>(left),
+                            .top = static_cast<int>(top),
+                            .advance = static_cast<int>(slot->advance.x >> 6)};
     }
-    FT_Set_Pixel_Sizes(face, 0, pixel_size);
-    return true;
+
+    const FT_Glyph_Metrics& m = slot->metrics;
+    return GlyphMetrics{.width = static_cast<int>(m.width >> 6),
+                        .rows = static_cast<int>(m.height >> 6),
+                        .left = static_cast<int>(m.horiBearingX >> 6),
+                        .top = static_cast<int>(m.horiBearingY >> 6),
+                        .advance = static_cast<int>(slot->advance.x >> 6)};
+}
+
+int FontRenderer::kerning(std::uint32_t left, std::uint32_t right) const noexcept
+{
+    if (!face || !FT_HAS_KERNING(face))
+    {
+        return 0;
+    }
+
+    FT_Vector delta{};
+    FT_Get_Kerning(face,
+                   FT_Get_Char_Index(face, left),
+                   FT_Get_Char_Index(face, right),
+                   FT_KERNING_DEFAULT,
+                   &delta);
+    return static_cast<int>(delta.x >> 6);
+}
+
+FontMetrics FontRenderer::font_metrics() const noexcept
+{
+    if (!face)
+    {
+        return FontMetrics{.pixel_size = m_pixel_size, .ascender = 0, .line_height = 0};
+    }
+    return FontMetrics{.pixel_size = m_pixel_size,
+                       .ascender = static_cast<int>(face->size->metrics.ascender >> 6),
+                       .line_height = static_cast<int>(face->size->metrics.height >> 6)};
 }
 
 FontRenderer::~FontRenderer() noexcept
@@ -76,7 +197,8 @@ FontRenderer::~FontRenderer() noexcept
     }
     if (library)
     {
-        FT_Done_FreeType(library);
+        // Not FT_Done_FreeType(): that would also release the static FT_Memory
+        FT_Done_Library(library);
     }
 }
 
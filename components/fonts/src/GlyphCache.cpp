@@ -0,0 +1,81 @@
+#include "GlyphCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace muc::fonts
+{
+
+const PackedGlyph* GlyphCache::find(std::uint32_t codepoint, int pixel_size) noexcept
+{
+    for (Slot& slot : m_slots)
+    {
+        if (slot.valid && slot.codepoint == codepoint && slot.pixel_size == pixel_size)
+        {
+            slot.last_used = ++m_clock;
+            m_stats.hits++;
+            return &slot.glyph;
+        }
+    }
+    m_stats.misses++;
+    return nullptr;
+}
+
+PackedGlyph* GlyphCache::allocate(std::uint32_t codepoint,
+                                  int pixel_size,
+                                  int width,
+                                  int rows,
+                                  std::uint8_t*& columns) noexcept
+{
+    // Free slot if there is one, otherwise the least recently used
+    Slot* victim = &m_slots[0];
+    for (Slot& slot : m_slots)
+    {
+        if (!slot.valid)
+        {
+            victim = &slot;
+            break;
+        }
+        if (slot.last_used < victim->last_used)
+        {
+            victim = &slot;
+        }
+    }
+    if (victim->valid)
+    {
+        m_stats.evictions++;
+    }
+
+    const auto index = static_cast<std::size_t>(victim - m_slots.data());
+    columns = m_arena.data() + index * kGlyphSlotBytes;
+    std::memset(columns, 0, kGlyphSlotBytes);
+
+    // Whole pages only: drop the rows of pages that do not fit
+    width = std::clamp(width, 0, static_cast<int>(kGlyphSlotBytes));
+    if (width > 0)
+    {
+        rows = std::min(rows, static_cast<int>(kGlyphSlotBytes) / width * 8);
+    }
+
+    victim->glyph = PackedGlyph{.columns = columns,
+                                .width = static_cast<std::uint8_t>(width),
+                                .rows = static_cast<std::uint8_t>(std::clamp(rows, 0, 255)),
+                                .left = 0,
+                                .top = 0,
+                                .advance = 0};
+    victim->codepoint = codepoint;
+    victim->pixel_size = static_cast<std::uint8_t>(pixel_size);
+    victim->last_used = ++m_clock;
+    victim->valid = true;
+    return &victim->glyph;
+}
+
+void GlyphCache::clear() noexcept
+{
+    for (Slot& slot : m_slots)
+    {
+        slot.valid = false;
+    }
+}
+
+} // namespace muc::fonts
@@ -0,0 +1,99 @@
+#include "LvglFont.h"
+
+#include <cstring>
+
+namespace muc::fonts
+{
+
+bool LvglFont::init(FontRenderer& renderer, int pixel_size, const lv_font_t* fallback) noexcept
+{
+    if (!renderer.face)
+    {
+        return false;
+    }
+
+    m_renderer = &renderer;
+    m_pixel_size = pixel_size;
+
+    // Line metrics at this size; the renderer keeps its previous size for its own users
+    const int previous_size = renderer.pixel_size();
+    renderer.set_pixel_size(pixel_size);
+    const FT_Size_Metrics& metrics = renderer.face->size->metrics;
+    m_font.line_height = static_cast<std::int32_t>(metrics.height >> 6);
+    m_font.base_line = static_cast<std::int32_t>(-(metrics.descender >> 6));
+    const FT_Face face = renderer.face;
+    m_font.underline_position =
+        static_cast<std::int8_t>(FT_MulFix(face->underline_position, metrics.y_scale) >> 6);
+    m_font.underline_thickness =
+        static_cast<std::int8_t>(FT_MulFix(face->underline_thickness, metrics.y_scale) >> 6);
+    renderer.set_pixel_size(previous_size);
+
+    m_font.get_glyph_dsc = get_glyph_dsc;
+    m_font.get_glyph_bitmap = get_glyph_bitmap;
+    m_font.release_glyph = nullptr;
+    m_font.subpx = LV_FONT_SUBPX_NONE;
+    m_font.fallback = fallback;
+    m_font.user_data = this;
+    return true;
+}
+
+const PackedGlyph* LvglFont::glyph(std::uint32_t codepoint) noexcept
+{
+    m_renderer->set_pixel_size(m_pixel_size);
+    return m_renderer->glyph(codepoint);
+}
+
+bool LvglFont::get_glyph_dsc(const lv_font_t* font,
+                             lv_font_glyph_dsc_t* dsc,
+                             std::uint32_t letter,
+                             std::uint32_t /*letter_next*/)
+{
+    auto* self = static_cast<LvglFont*>(font->user_data);
+
+    // Let the fallback font draw what the TTF lacks instead of .notdef
+    if (!self->m_renderer->has_glyph(letter))
+    {
+        return false;
+    }
+
+    const PackedGlyph* glyph = self->glyph(letter);
+    if (!glyph)
+    {
+        return false;
+    }
+
+    dsc->resolved_font = font;
+    dsc->adv_w = static_cast<std::uint16_t>(glyph->advance);
+    dsc->box_w = glyph->width;
+    dsc->box_h = glyph->rows;
+    dsc->ofs_x = glyph->left;
+    dsc->ofs_y = static_cast<std::int16_t>(glyph->top - glyph->rows); // baseline -> bottom
+    dsc->format = LV_FONT_GLYPH_FORMAT_A1;
+    dsc->is_placeholder = 0;
+    dsc->gid.index = letter; // looked up again (a cache hit) by get_glyph_bitmap()
+    return true;
+}
+
+const void* LvglFont::get_glyph_bitmap(lv_font_glyph_dsc_t* dsc, lv_draw_buf_t* draw_buf)
+{
+    auto* self = static_cast<LvglFont*>(dsc->resolved_font->user_data);
+    const PackedGlyph* glyph = self->glyph(dsc->gid.index);
+    if (!glyph || glyph->width == 0 || glyph->rows == 0)
+    {
+        return nullptr;
+    }
+
+    // LVGL draws A1 glyphs from an A8 mask, as lv_font_fmt_txt hands them over
+    const std::uint32_t stride = draw_buf->header.stride;
+    for (int row = 0; row < glyph->rows; ++row)
+    {
+        std::uint8_t* out = draw_buf->data + row * stride;
+        for (int col = 0; col < glyph->width; ++col)
+        {
+            out[col] = glyph->pixel(col, row) ? 0xFF : 0x00;
+        }
+    }
+    return draw_buf;
+}
+
+} // namespace muc::fonts
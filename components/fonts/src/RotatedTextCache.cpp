@@ -0,0 +1,196 @@
+#include "RotatedTextCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Affine.h"
+#include "TextRenderer.h"
+
+namespace muc::fonts
+{
+
+namespace
+{
+// Rotated glyphs are packed here before drawing; 16 px glyphs take well under 128 bytes
+constexpr std::size_t kMaxRotatedGlyphBytes = 256;
+} // namespace
+
+RotatedTextCache::RotatedTextCache(std::span<std::uint8_t> storage) noexcept
+: m_storage(storage)
+{
+    m_stats.bytes_total = storage.size();
+}
+
+void RotatedTextCache::reset(FontRenderer& font,
+                             std::string_view text,
+                             int step_degrees,
+                             int centre_x,
+                             int centre_y) noexcept
+{
+    constexpr int kMinStep = (360 + kMaxRotatedFrames - 1) / kMaxRotatedFrames;
+
+    layout_text(font, text, 0, m_layout);
+    m_step = std::max(step_degrees, kMinStep);
+    m_centre_x = centre_x;
+    m_centre_y = centre_y;
+    m_frames.fill(Frame{});
+    m_stats = RotatedTextStats{};
+    m_stats.bytes_total = m_storage.size();
+}
+
+void RotatedTextCache::draw(FontRenderer& font, const PageBitmap& target, int degrees) noexcept
+{
+    if (m_step == 0)
+    {
+        target.clear();
+        return;
+    }
+
+    int d = degrees % 360;
+    if (d < 0)
+    {
+        d += 360;
+    }
+    Frame& frame = m_frames[static_cast<std::size_t>(d / m_step)];
+
+    if (frame.valid)
+    {
+        m_stats.hits++;
+        target.clear();
+        const std::uint8_t* src = m_storage.data() + frame.offset;
+        for (int page = frame.page; page < frame.page + frame.pages; ++page)
+        {
+            std::memcpy(target.data + page * target.width + frame.x, src, frame.width);
+            src += frame.width;
+        }
+        return;
+    }
+
+    m_stats.misses++;
+    render(font, target, d / m_step * m_step);
+    store(target, frame);
+}
+
+void RotatedTextCache::render(FontRenderer& font,
+                              const PageBitmap& target,
+                              int degrees) const noexcept
+{
+    target.clear();
+    const FT_Face face = font.face;
+    if (!face)
+    {
+        return;
+    }
+
+    // Clockwise on screen, in FreeType's space (26.6, y up)
+    const FT_Fixed c = cos_fixed(degrees);
+    const FT_Fixed s = sin_fixed(degrees);
+    FT_Matrix matrix{.xx = c, .xy = s, .yx = -s, .yy = c};
+
+    // Pen origin of the layout: the centre, plus the rotated way from the centre of the
+    // ink back to the origin. Snapped to whole pixels, so the upright frame rasterizes
+    // exactly like the upright glyphs.
+    const TextBounds box = m_layout.bounds();
+    FT_Vector origin{.x = -(box.left + box.right) * 32, .y = (box.top + box.bottom) * 32};
+    FT_Vector_Transform(&origin, &matrix);
+    origin.x = (origin.x + m_centre_x * 64 + 32) & ~63;
+    origin.y = (origin.y - m_centre_y * 64 + 32) & ~63;
+
+    for (const LayoutGlyph& placed : m_layout.glyphs())
+    {
+        if (placed.width == 0 || placed.rows == 0)
+        {
+            continue;
+        }
+
+        // Layout positions already include kerning; they rotate like everything else
+        FT_Vector pen{.x = placed.x * 64, .y = -placed.y * 64};
+        FT_Vector_Transform(&pen, &matrix);
+        pen.x += origin.x;
+        pen.y += origin.y;
+
+        FT_Set_Transform(face, &matrix, &pen);
+        if (FT_Load_Char(face, placed.codepoint, raster_load_flags(font.raster_options().mode)))
+        {
+            continue;
+        }
+
+        // Packed like an upright glyph, then drawn with its top-left corner at the bitmap
+        // position FreeType computed
+        const FT_GlyphSlot slot = face->glyph;
+        const FT_Bitmap& bitmap = slot->bitmap;
+        const std::size_t bytes = packed_glyph_bytes(static_cast<int>(bitmap.width),
+                                                     static_cast<int>(bitmap.rows));
+        if (bitmap.width > 255 || bitmap.rows > 255 || bytes > kMaxRotatedGlyphBytes)
+        {
+            continue;
+        }
+        std::array<std::uint8_t, kMaxRotatedGlyphBytes> columns{};
+        pack_bitmap(bitmap, font.raster_options(), columns.data());
+        const PackedGlyph glyph{.columns = columns.data(),
+                                .width = static_cast<std::uint8_t>(bitmap.width),
+                                .rows = static_cast<std::uint8_t>(bitmap.rows),
+                                .left = 0,
+                                .top = 0,
+                                .advance = 0};
+        draw_glyph(target, glyph, slot->bitmap_left, -slot->bitmap_top);
+    }
+
+    // FontRenderer::glyph() and metrics() expect upright outlines
+    FT_Set_Transform(face, nullptr, nullptr);
+}
+
+void RotatedTextCache::store(const PageBitmap& target, Frame& frame) noexcept
+{
+    // Page-aligned box of the non-blank bytes
+    const int pages = (target.height + 7) / 8;
+    int x_begin = target.width;
+    int x_end = 0;
+    int page_begin = pages;
+    int page_end = 0;
+    for (int page = 0; page < pages; ++page)
+    {
+        const std::uint8_t* row = target.data + page * target.width;
+        for (int x = 0; x < target.width; ++x)
+        {
+            if (row[x] != 0)
+            {
+                x_begin = std::min(x_begin, x);
+                x_end = std::max(x_end, x + 1);
+                page_begin = std::min(page_begin, page);
+                page_end = page + 1;
+            }
+        }
+    }
+    if (x_end <= x_begin)
+    {
+        frame = Frame{.offset = 0, .x = 0, .page = 0, .width = 0, .pages = 0, .valid = true};
+        m_stats.frames++;
+        return;
+    }
+
+    const int width = x_end - x_begin;
+    const auto bytes = static_cast<std::size_t>(width * (page_end - page_begin));
+    if (bytes > m_storage.size() - m_stats.bytes_used)
+    {
+        m_stats.uncached++;
+        return;
+    }
+
+    frame = Frame{.offset = static_cast<std::uint32_t>(m_stats.bytes_used),
+                  .x = static_cast<std::uint8_t>(x_begin),
+                  .page = static_cast<std::uint8_t>(page_begin),
+                  .width = static_cast<std::uint8_t>(width),
+                  .pages = static_cast<std::uint8_t>(page_end - page_begin),
+                  .valid = true};
+    std::uint8_t* dst = m_storage.data() + frame.offset;
+    for (int page = page_begin; page < page_end; ++page)
+    {
+        std::memcpy(dst, target.data + page * target.width + x_begin, frame.width);
+        dst += frame.width;
+    }
+    m_stats.bytes_used += bytes;
+    m_stats.frames++;
+}
+
+} // namespace muc::fonts
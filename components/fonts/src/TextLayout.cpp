@@ -0,0 +1,171 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace muc::fonts
+{
+
+static_assert(kMaxLayoutKeyBytes <= 255, "Slot::text_size is 8 bits");
+
+void TextLayout::reset(int line_height, int max_width) noexcept
+{
+    m_count = 0;
+    m_line_start = 0;
+    m_break = 0;
+    m_line = 0;
+    m_pen_x = 0;
+    m_line_height = line_height;
+    m_max_width = max_width;
+    m_truncated = false;
+    m_bounds = TextBounds{};
+}
+
+bool TextLayout::append(std::uint32_t codepoint, const GlyphMetrics& metrics, int kerning) noexcept
+{
+    if (m_count == kMaxLayoutGlyphs)
+    {
+        m_truncated = true;
+        return false;
+    }
+
+    // Only ink can overflow a line, so spaces never wrap and may trail past its end
+    int x = m_pen_x + kerning;
+    const bool inked = metrics.width > 0 && metrics.rows > 0;
+    while (m_max_width > 0 && inked && m_count > m_line_start &&
+           x + metrics.left + metrics.width > m_max_width)
+    {
+        // Kerning only applies while the left neighbour stays on the same line
+        const bool carried = wrap();
+        x = m_pen_x + (carried ? kerning : 0);
+    }
+
+    m_glyphs[m_count++] = LayoutGlyph{.codepoint = codepoint,
+                                      .x = static_cast<std::int16_t>(x),
+                                      .y = static_cast<std::int16_t>(m_line * m_line_height),
+                                      .left = static_cast<std::int8_t>(metrics.left),
+                                      .top = static_cast<std::int8_t>(metrics.top),
+                                      .width = static_cast<std::uint8_t>(metrics.width),
+                                      .rows = static_cast<std::uint8_t>(metrics.rows)};
+    m_pen_x = x + metrics.advance;
+    if (codepoint == ' ')
+    {
+        m_break = m_count;
+    }
+    return true;
+}
+
+void TextLayout::new_line() noexcept
+{
+    m_line++;
+    m_pen_x = 0;
+    m_line_start = m_count;
+    m_break = m_count;
+}
+
+bool TextLayout::wrap() noexcept
+{
+    // Break after the last space if the line has one, otherwise in front of the new glyph
+    const std::size_t first = m_break > m_line_start ? m_break : m_count;
+    const int shift = first < m_count ? m_glyphs[first].x : m_pen_x;
+
+    m_line++;
+    for (std::size_t i = first; i < m_count; ++i)
+    {
+        m_glyphs[i].x = static_cast<std::int16_t>(m_glyphs[i].x - shift);
+        m_glyphs[i].y = static_cast<std::int16_t>(m_line * m_line_height);
+    }
+    m_pen_x -= shift;
+    m_line_start = first;
+    m_break = first;
+    return first < m_count;
+}
+
+void TextLayout::finish() noexcept
+{
+    bool inked = false;
+    for (const LayoutGlyph& g : glyphs())
+    {
+        if (g.width == 0 || g.rows == 0)
+        {
+            continue;
+        }
+
+        const TextBounds box{.left = g.x + g.left,
+                             .top = g.y - g.top,
+                             .right = g.x + g.left + g.width,
+                             .bottom = g.y - g.top + g.rows};
+        if (!inked)
+        {
+            m_bounds = box;
+            inked = true;
+            continue;
+        }
+        m_bounds.left = std::min(m_bounds.left, box.left);
+        m_bounds.top = std::min(m_bounds.top, box.top);
+        m_bounds.right = std::max(m_bounds.right, box.right);
+        m_bounds.bottom = std::max(m_bounds.bottom, box.bottom);
+    }
+}
+
+const TextLayout* TextLayoutCache::find(std::string_view text,
+                                        int pixel_size,
+                                        int max_width) noexcept
+{
+    if (text.size() <= kMaxLayoutKeyBytes)
+    {
+        for (Slot& slot : m_slots)
+        {
+            if (slot.valid && slot.pixel_size == pixel_size && slot.max_width == max_width &&
+                slot.text_size == text.size() &&
+                std::memcmp(slot.text.data(), text.data(), text.size()) == 0)
+            {
+                slot.last_used = ++m_clock;
+                m_stats.hits++;
+                return &slot.layout;
+            }
+        }
+    }
+    m_stats.misses++;
+    return nullptr;
+}
+
+TextLayout& TextLayoutCache::claim(std::string_view text, int pixel_size, int max_width) noexcept
+{
+    // Free slot if there is one, otherwise the least recently used
+    Slot* victim = &m_slots[0];
+    for (Slot& slot : m_slots)
+    {
+        if (!slot.valid)
+        {
+            victim = &slot;
+            break;
+        }
+        if (slot.last_used < victim->last_used)
+        {
+            victim = &slot;
+        }
+    }
+
+    // A text too long to key the slot still gets laid out in it, but never found again
+    victim->valid = text.size() <= kMaxLayoutKeyBytes;
+    if (victim->valid)
+    {
+        std::memcpy(victim->text.data(), text.data(), text.size());
+        victim->text_size = static_cast<std::uint8_t>(text.size());
+    }
+    victim->pixel_size = static_cast<std::uint8_t>(pixel_size);
+    victim->max_width = static_cast<std::int16_t>(max_width);
+    victim->last_used = ++m_clock;
+    return victim->layout;
+}
+
+void TextLayoutCache::clear() noexcept
+{
+    for (Slot& slot : m_slots)
+    {
+        slot.valid = false;
+    }
+}
+
+} // namespace muc::fonts
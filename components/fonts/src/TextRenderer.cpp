@@ -0,0 +1,71 @@
+#include "TextRenderer.h"
+
+#include <algorithm>
+
+namespace muc::fonts
+{
+
+void draw_glyph(const PageBitmap& target, const PackedGlyph& glyph, int x, int y) noexcept
+{
+    const int left = x + glyph.left;
+    const int top = y - glyph.top;
+
+    // Clip once: the visible columns of the glyph and the screen pages it touches. A glyph
+    // page lands `shift` rows down into screen page first_page + p, spilling its bottom
+    // rows into the page below.
+    const int col_begin = std::max(0, -left);
+    const int col_end = std::min(static_cast<int>(glyph.width), target.width - left);
+    const int first_page = top >> 3;
+    const int shift = top & 7;
+    const int screen_pages = (target.height + 7) / 8;
+    const int page_begin = std::max(first_page, 0);
+    const int page_end =
+        std::min(first_page + glyph.pages() + (shift != 0 ? 1 : 0), screen_pages);
+    if (col_begin >= col_end || page_begin >= page_end || top >= target.height)
+    {
+        return;
+    }
+
+    const int count = col_end - col_begin;
+    std::uint8_t* dst = target.data + page_begin * target.width + left + col_begin;
+    for (int page = page_begin; page < page_end; ++page, dst += target.width)
+    {
+        // Rows below the window in a partial last page stay clear, as drawPixel() keeps them
+        const auto mask = static_cast<std::uint8_t>(
+            page == screen_pages - 1 && (target.height & 7) ? (1u << (target.height & 7)) - 1
+                                                               : 0xFFu);
+
+        // The glyph page starting in this screen page, and the one spilling into it
+        const int start = page - first_page;
+        const std::uint8_t* lower =
+            start < glyph.pages() ? glyph.columns + start * glyph.width + col_begin : nullptr;
+        const std::uint8_t* upper =
+            shift != 0 && start > 0 ? glyph.columns + (start - 1) * glyph.width + col_begin
+                                    : nullptr;
+
+        if (lower && upper)
+        {
+            for (int col = 0; col < count; ++col)
+            {
+                dst[col] |= static_cast<std::uint8_t>(
+                    ((lower[col] << shift) | (upper[col] >> (8 - shift))) & mask);
+            }
+        }
+        else if (lower)
+        {
+            for (int col = 0; col < count; ++col)
+            {
+                dst[col] |= static_cast<std::uint8_t>((lower[col] << shift) & mask);
+            }
+        }
+        else
+        {
+            for (int col = 0; col < count; ++col)
+            {
+                dst[col] |= static_cast<std::uint8_t>((upper[col] >> (8 - shift)) & mask);
+            }
+        }
+    }
+}
+
+} // namespace muc::fonts
@@ -0,0 +1,136 @@
+#include "Utf8.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace muc::fonts
+{
+
+std::uint32_t decode_utf8_sequence(std::string_view& text) noexcept
+{
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(text.data());
+    const std::uint8_t lead = bytes[0];
+
+    // --- 1-BYTE SEQUENCE (ASCII) ---
+    // Bit pattern: 0xxxxxxx
+    if (lead < 0x80)
+    {
+        text.remove_prefix(1);
+        return lead;
+    }
+
+    // Sequence length and the valid range of the second byte (Unicode table 3-7). The
+    // narrowed ranges rule out overlong forms (E0, F0), surrogates (ED) and values above
+    // U+10FFFF (F4); C0, C1 and F5..FF can only start overlong or out-of-range forms.
+    std::size_t length = 0;
+    std::uint32_t codepoint = 0;
+    std::uint8_t low = 0x80;
+    std::uint8_t high = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        // 110xxxxx 10xxxxxx: U+0080..U+07FF
+        length = 2;
+        codepoint = lead & 0x1F;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        // 1110xxxx 10xxxxxx 10xxxxxx: U+0800..U+FFFF
+        length = 3;
+        codepoint = lead & 0x0F;
+        low = (lead == 0xE0) ? 0xA0 : 0x80;
+        high = (lead == 0xED) ? 0x9F : 0xBF;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        // 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx: U+10000..U+10FFFF
+        length = 4;
+        codepoint = lead & 0x07;
+        low = (lead == 0xF0) ? 0x90 : 0x80;
+        high = (lead == 0xF4) ? 0x8F : 0xBF;
+    }
+    else
+    {
+        text.remove_prefix(1);
+        return kReplacementChar;
+    }
+
+    for (std::size_t i = 1; i < length; ++i)
+    {
+        // Truncated or bad continuation: drop only the bytes that were still plausible
+        if (i >= text.size() || bytes[i] < low || bytes[i] > high)
+        {
+            text.remove_prefix(i);
+            return kReplacementChar;
+        }
+        codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+        low = 0x80;
+        high = 0xBF;
+    }
+
+    text.remove_prefix(length);
+    return codepoint;
+}
+
+std::size_t ascii_prefix(std::string_view text) noexcept
+{
+    // size_t is the register width: 4 bytes per step on the ESP32-C3, 8 on the host
+    using Word = std::size_t;
+    constexpr Word kHighBits = static_cast<Word>(0x8080808080808080ull);
+
+    std::size_t i = 0;
+    for (; i + sizeof(Word) <= text.size(); i += sizeof(Word))
+    {
+        Word word;
+        std::memcpy(&word, text.data() + i, sizeof(word));
+        if (word & kHighBits)
+        {
+            break;
+        }
+    }
+    while (i < text.size() && static_cast<std::uint8_t>(text[i]) < 0x80)
+    {
+        ++i;
+    }
+    return i;
+}
+
+std::size_t decode_utf8(std::string_view text, std::span<std::uint32_t> out) noexcept
+{
+    std::size_t count = 0;
+    while (!text.empty() && count < out.size())
+    {
+        const std::size_t ascii = std::min(ascii_prefix(text), out.size() - count);
+        for (std::size_t i = 0; i < ascii; ++i)
+        {
+            out[count++] = static_cast<std::uint8_t>(text[i]);
+        }
+        text.remove_prefix(ascii);
+
+        if (!text.empty() && count < out.size())
+        {
+            out[count++] = decode_utf8(text);
+        }
+    }
+    return count;
+}
+
+std::size_t utf8_length(std::string_view text) noexcept
+{
+    std::size_t count = 0;
+    while (!text.empty())
+    {
+        const std::size_t ascii = ascii_prefix(text);
+        count += ascii;
+        text.remove_prefix(ascii);
+
+        if (!text.empty())
+        {
+            decode_utf8(text);
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace muc::fonts
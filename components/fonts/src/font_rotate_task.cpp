@@ -1,19 +1,36 @@
 #include <esp_log.h>
+#include <esp_timer.h>
 
-#include <cmath>
+#include <array>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 
-#include "FontRenderer.h"
+#include "Affine.h"
+#include "FontAtlas.h"
+#include "TextLayout.h"
+#include "TextRenderer.h"
 #include "ssd1306.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <sdkconfig.h>
+
+#if CONFIG_FONTS_FREETYPE
+#include "FontRenderer.h"
+#endif
+#if CONFIG_FONTS_ROTATE_CACHE
+#include "RotatedTextCache.h"
+#endif
 
 namespace
 {
 const char* TAG = "FontExample";
 
+// 25 frames per second
+constexpr int kFrameMs = 40;
+constexpr int kDegreesPerFrame = CONFIG_FONTS_ROTATE_STEP_DEGREES;
+
+#if CONFIG_FONTS_FREETYPE
 extern "C"
 {
 extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_start[] asm(
@@ -21,6 +38,7 @@ extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_start[] asm(
 extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_end[] asm(
     "_binary_oled_subset_ascii_umlaut_ttf_end");
 }
+#endif
 } // namespace
 
 namespace muc::fonts
@@ -29,135 +47,130 @@ void font_rotate_task(void* pvParameters)
 {
     configASSERT(pvParameters && "font_rotate_task: pvParameters is nullptr");
     auto& oled = *static_cast<muc::ssd1306::Oled*>(pvParameters);
-    muc::fonts::FontRenderer renderer;
+
+#if CONFIG_FONTS_FREETYPE
+    // Static: the glyph cache is too large for the task stack
+    static muc::fonts::FontRenderer font;
 
     const std::size_t font_size =
         reinterpret_cast<std::uintptr_t>(_binary_oled_subset_ascii_umlaut_ttf_end) -
         reinterpret_cast<std::uintptr_t>(_binary_oled_subset_ascii_umlaut_ttf_start);
 
-    if (!renderer.init(_binary_oled_subset_ascii_umlaut_ttf_start, font_size, 16))
+    if (!font.init(_binary_oled_subset_ascii_umlaut_ttf_start, font_size, 16))
     {
         ESP_LOGE(TAG, "Failed to initialize FontRenderer");
         vTaskDelete(nullptr);
     }
+#else
+    const AtlasFont* atlas = find_atlas_font(16);
+    if (!atlas)
+    {
+        ESP_LOGE(TAG, "No 16 px glyph atlas (CONFIG_FONTS_ATLAS_SIZES)");
+        vTaskDelete(nullptr);
+    }
+    const AtlasFont& font = *atlas;
+#endif
 
-    double angle_deg = 0.0;
     const char* display_text = "Grüße";
+    const PageBitmap screen = page_bitmap(oled);
+
+    // Optional aesthetic shift upward
+    const int centre_x = screen.width / 2;
+    const int centre_y = screen.height / 2 - 4;
+
+#if CONFIG_FONTS_ROTATE_CACHE
+    // -------------------------------------------------------------------------
+    // Every angle is rasterized once by FreeType with the outline rotated; the
+    // frames are kept, so after the first turn each frame is a copy
+    // -------------------------------------------------------------------------
+    // Static: far too large for the task stack
+    static std::array<std::uint8_t, CONFIG_FONTS_ROTATE_CACHE_BYTES> frame_storage;
+    static RotatedTextCache frames(frame_storage);
+    frames.reset(font, display_text, kDegreesPerFrame, centre_x, centre_y);
+#else
+    // Static: too large for the task stack
+    static TextLayoutCache layouts;
+    static std::array<std::uint8_t, 512> text_pixels;
+
+    // -------------------------------------------------------------------------
+    // PASS 1: Lay out the text and draw it upright into an offscreen bitmap of
+    // exactly its bounding box. The text never changes, so this happens once.
+    // -------------------------------------------------------------------------
+    const TextLayout& layout = layouts.layout(font, display_text, oled.geometry().width);
+    const TextBounds box = layout.bounds();
+    const PageBitmap text{.data = text_pixels.data(),
+                          .width = box.right - box.left,
+                          .height = box.bottom - box.top};
+    if (PageBitmap::bytes(text.width, text.height) > text_pixels.size())
+    {
+        ESP_LOGE(TAG, "Text bitmap %dx%d does not fit its buffer", text.width, text.height);
+        vTaskDelete(nullptr);
+    }
+    text.clear();
+    draw_layout(text, font, layout, -box.left, -box.top);
+
+    // -------------------------------------------------------------------------
+    // STEP 2: Rotate about the centre of the text, placed at the centre of the
+    // screen. Both centres are whole pixels: with a half-pixel one, odd-sized text
+    // samples exactly on source pixel edges at right angles.
+    // -------------------------------------------------------------------------
+    const Affine from_text_centre =
+        Affine::translation(-to_fixed(text.width / 2), -to_fixed(text.height / 2));
+    const Affine to_screen_centre = Affine::translation(to_fixed(centre_x), to_fixed(centre_y));
+#endif
+
+    int angle_deg = 0;
+    int turn = 0;
+    std::int64_t turn_us = 0;
+    int turn_frames = 0;
 
     while (true)
     {
-        oled.clear();
+        const std::int64_t start_us = esp_timer_get_time();
 
         // ---------------------------------------------------------------------
-        // PASS 1: Compute bounding box
+        // PASS 3: Render rotated text
         // ---------------------------------------------------------------------
-        double minX = 1e9, maxX = -1e9;
-        double minY = 1e9, maxY = -1e9;
-
-        const char* p_measure = display_text;
-        double pen_x_measure = 0.0;
-
-        while (*p_measure)
-        {
-            std::uint32_t cp = decode_utf8(p_measure);
-            FT_Load_Char(renderer.face, cp, FT_LOAD_RENDER);
-            FT_GlyphSlot g = renderer.face->glyph;
-
-            if (g->bitmap.width > 0 && g->bitmap.rows > 0)
-            {
-                double left = pen_x_measure + g->bitmap_left;
-                double right = left + g->bitmap.width;
-                double top = g->bitmap_top;
-                double bottom = top - g->bitmap.rows;
-
-                if (left < minX)
-                {
-                    minX = left;
-                }
-                if (right > maxX)
-                {
-                    maxX = right;
-                }
-                if (top > maxY)
-                {
-                    maxY = top;
-                }
-                if (bottom < minY)
-                {
-                    minY = bottom;
-                }
-            }
-
-            pen_x_measure += (g->advance.x >> 6);
-        }
-
-        double text_mid_x = (minX + maxX) * 0.5;
-        double text_mid_y = (minY + maxY) * 0.5;
-
-        // ---------------------------------------------------------------------
-        // STEP 2: Use instance geometry
-        // ---------------------------------------------------------------------
-        const auto& g = oled.geometry();
-        double screen_cx = g.width * 0.5;
-        double screen_cy = g.height * 0.5;
-
-        // Optional aesthetic shift upward
-        screen_cy -= 4.0;
-
-        // ---------------------------------------------------------------------
-        // STEP 3: Rotation math
-        // ---------------------------------------------------------------------
-        double rad = -(angle_deg * M_PI / 180.0);
-        double cos_a = std::cos(rad);
-        double sin_a = std::sin(rad);
+#if CONFIG_FONTS_ROTATE_CACHE
+        frames.draw(font, screen, angle_deg);
+#else
+        // Fixed point, every covered pixel sampled
+        oled.clear();
+        blit_affine(screen,
+                    text,
+                    to_screen_centre * Affine::rotation(angle_deg) * from_text_centre);
+#endif
 
-        // ---------------------------------------------------------------------
-        // PASS 4: Render rotated text
-        // ---------------------------------------------------------------------
-        const char* p_draw = display_text;
-        double pen_x_draw = 0.0;
-
-        while (*p_draw)
-        {
-            std::uint32_t cp = decode_utf8(p_draw);
-            FT_Load_Char(renderer.face, cp, FT_LOAD_RENDER);
-            FT_GlyphSlot g = renderer.face->glyph;
-
-            for (int row = 0; row < g->bitmap.rows; ++row)
-            {
-                for (int col = 0; col < g->bitmap.width; ++col)
-                {
-                    if (g->bitmap.buffer[row * g->bitmap.pitch + col] > 64)
-                    {
-                        double lx = pen_x_draw + g->bitmap_left + col;
-                        double ly = g->bitmap_top - row;
-
-                        double rx = lx - text_mid_x;
-                        double ry = ly - text_mid_y;
-
-                        double rot_x = rx * cos_a - ry * sin_a;
-                        double rot_y = rx * sin_a + ry * cos_a;
-
-                        int px = static_cast<int>(screen_cx + rot_x);
-                        int py = static_cast<int>(screen_cy - rot_y);
-
-                        oled.drawPixel(px, py, true);
-                    }
-                }
-            }
-
-            pen_x_draw += (g->advance.x >> 6);
-        }
+        turn_us += esp_timer_get_time() - start_us;
+        turn_frames++;
 
         oled.update();
 
-        angle_deg += 15.0;
-        if (angle_deg >= 360.0)
+        angle_deg = (angle_deg + kDegreesPerFrame) % 360;
+
+        // The first turn fills the cache (if any), the second shows the steady state
+        if (angle_deg < kDegreesPerFrame && turn < 2)
         {
-            angle_deg = 0.0;
+            ESP_LOGI(TAG,
+                     "Turn %d: %d frames, %lld us/frame",
+                     turn + 1,
+                     turn_frames,
+                     static_cast<long long>(turn_us / turn_frames));
+#if CONFIG_FONTS_ROTATE_CACHE
+            const RotatedTextStats stats = frames.stats();
+            ESP_LOGI(TAG,
+                     "Frame cache: %lu frames in %u of %u bytes, %lu not stored",
+                     static_cast<unsigned long>(stats.frames),
+                     static_cast<unsigned>(stats.bytes_used),
+                     static_cast<unsigned>(stats.bytes_total),
+                     static_cast<unsigned long>(stats.uncached));
+#endif
+            turn++;
+            turn_us = 0;
+            turn_frames = 0;
         }
 
-        vTaskDelay(pdMS_TO_TICKS(200));
+        vTaskDelay(pdMS_TO_TICKS(kFrameMs));
     }
 }
 
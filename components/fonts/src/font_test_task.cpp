@@ -5,15 +5,22 @@
 #include <cstdio>
 #include <cstring>
 
-#include "FontRenderer.h"
+#include "FontAtlas.h"
+#include "TextRenderer.h"
 #include "ssd1306.h"
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <sdkconfig.h>
+
+#if CONFIG_FONTS_FREETYPE
+#include "FontRenderer.h"
+#endif
 
 namespace
 {
 const char* TAG = "FontTest";
 
+#if CONFIG_FONTS_FREETYPE
 // Embedded ASCII-only font
 extern "C"
 {
@@ -22,58 +29,40 @@ extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_start[] asm(
 extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_end[] asm(
     "_binary_oled_subset_ascii_umlaut_ttf_end");
 }
+#endif
 } // namespace
 
 namespace muc::fonts
 {
 
-static void draw_text(muc::ssd1306::Oled& oled,
-                      FontRenderer& renderer,
-                      int x,
-                      int y,
-                      const char* text)
-{
-    const char* p = text;
-    int pen_x = x;
-
-    while (*p)
-    {
-        std::uint32_t cp = decode_utf8(p);
-        FT_Load_Char(renderer.face, cp, FT_LOAD_RENDER);
-        FT_GlyphSlot g = renderer.face->glyph;
-
-        for (int row = 0; row < g->bitmap.rows; ++row)
-        {
-            for (int col = 0; col < g->bitmap.width; ++col)
-            {
-                if (g->bitmap.buffer[row * g->bitmap.pitch + col] > 64)
-                {
-                    oled.drawPixel(pen_x + g->bitmap_left + col, y + g->bitmap_top - row, true);
-                }
-            }
-        }
-
-        pen_x += (g->advance.x >> 6);
-    }
-}
-
 void font_test_task(void* pvParameters)
 {
     configASSERT(pvParameters && "font_test_task: pvParameters is nullptr");
     auto& oled = *static_cast<muc::ssd1306::Oled*>(pvParameters);
     const auto& geom = oled.geometry();
 
-    FontRenderer renderer;
+#if CONFIG_FONTS_FREETYPE
+    // Static: the glyph cache is too large for the task stack
+    static FontRenderer font;
 
     const std::size_t font_size =
         reinterpret_cast<std::uintptr_t>(_binary_oled_subset_ascii_umlaut_ttf_end) -
         reinterpret_cast<std::uintptr_t>(_binary_oled_subset_ascii_umlaut_ttf_start);
 
-    if (!renderer.init(_binary_oled_subset_ascii_umlaut_ttf_start, font_size, 10))
+    if (!font.init(_binary_oled_subset_ascii_umlaut_ttf_start, font_size, 10))
     {
         ESP_LOGE(TAG, "Font init failed");
         vTaskDelete(nullptr);
     }
+#else
+    const AtlasFont* atlas = find_atlas_font(10);
+    if (!atlas)
+    {
+        ESP_LOGE(TAG, "No 10 px glyph atlas (CONFIG_FONTS_ATLAS_SIZES)");
+        vTaskDelete(nullptr);
+    }
+    const AtlasFont& font = *atlas;
+#endif
 
     while (true)
     {
@@ -107,7 +96,7 @@ void font_test_task(void* pvParameters)
         {
             std::array<std::uint8_t, 16> buf{};
             std::snprintf(reinterpret_cast<char*>(buf.data()), buf.size(), "%d", x);
-            draw_text(oled, renderer, x, 12, reinterpret_cast<char*>(buf.data()));
+            draw_text(oled, font, x, 20, reinterpret_cast<char*>(buf.data()));
         }
 
         // ---------------------------------------------------------------------
@@ -123,7 +112,7 @@ void font_test_task(void* pvParameters)
         {
             std::array<std::uint8_t, 16> buf{};
             std::snprintf(reinterpret_cast<char*>(buf.data()), buf.size(), "%d", y);
-            draw_text(oled, renderer, 12, y, reinterpret_cast<char*>(buf.data()));
+            draw_text(oled, font, 12, y + 8, reinterpret_cast<char*>(buf.data()));
         }
 
         // ---------------------------------------------------------------------
@@ -138,13 +127,22 @@ void font_test_task(void* pvParameters)
                       (int)geom.width,
                       (int)geom.height);
 
-        draw_text(oled, renderer, 2, geom.height - 10, info);
+        draw_text(oled, font, 2, geom.height - 2, info);
 
         // ---------------------------------------------------------------------
         // 5. Update display
         // ---------------------------------------------------------------------
         oled.update();
 
+#if CONFIG_FONTS_FREETYPE
+        const GlyphCacheStats stats = font.cache_stats();
+        ESP_LOGD(TAG,
+                 "glyph cache: %lu hits, %lu misses, %lu evictions",
+                 static_cast<unsigned long>(stats.hits),
+                 static_cast<unsigned long>(stats.misses),
+                 static_cast<unsigned long>(stats.evictions));
+#endif
+
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
 }
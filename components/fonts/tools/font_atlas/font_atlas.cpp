@@ -0,0 +1,355 @@
+// Build-time glyph atlas compiler.
+//
+// Rasterizes every character of a TTF at the requested pixel sizes, exactly the way
+// FontRenderer does at runtime (raster_load_flags() and pack_bitmap() with the same
+// RasterOptions), packs the bitmaps into SSD1306 page layout, tabulates the font's kerning
+// at each size and writes everything as a C++ source defining muc::fonts::atlas_fonts().
+// The firmware then draws and lays out text without FreeType or the TTF.
+//
+//   font_atlas [--raster threshold|dither|mono] [--threshold <0-255>]
+//              <font.ttf> <output.cpp> <pixel size>...
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "GlyphRaster.h"
+
+namespace
+{
+
+using muc::fonts::pack_bitmap;
+using muc::fonts::packed_glyph_bytes;
+using muc::fonts::raster_load_flags;
+using muc::fonts::RasterMode;
+using muc::fonts::RasterOptions;
+
+RasterOptions s_raster;
+
+struct Glyph
+{
+    std::uint32_t codepoint;
+    std::size_t offset; // into Size::columns
+    int width;
+    int rows;
+    int left;
+    int top;
+    int advance;
+};
+
+struct Kerning
+{
+    std::uint32_t left;
+    std::uint32_t right;
+    int x;
+};
+
+struct Size
+{
+    int pixel_size;
+    int ascender;
+    int line_height;
+    std::vector<Glyph> glyphs;
+    std::vector<Kerning> kerning;
+    Glyph fallback;
+    std::vector<std::uint8_t> columns;
+};
+
+// Packs the glyph in `face->glyph` into `out`; false if it does not fit PackedGlyph
+bool pack(FT_Face face, std::uint32_t codepoint, Size& out, Glyph& glyph)
+{
+    const FT_GlyphSlot slot = face->glyph;
+    const FT_Bitmap& bitmap = slot->bitmap;
+    glyph = Glyph{.codepoint = codepoint,
+                  .offset = out.columns.size(),
+                  .width = static_cast<int>(bitmap.width),
+                  .rows = static_cast<int>(bitmap.rows),
+                  .left = slot->bitmap_left,
+                  .top = slot->bitmap_top,
+                  .advance = static_cast<int>(slot->advance.x >> 6)};
+
+    if (glyph.width > 255 || glyph.rows > 255 || glyph.left < -128 || glyph.left > 127 ||
+        glyph.top < -128 || glyph.top > 127)
+    {
+        std::fprintf(stderr,
+                     "font_atlas: U+%04X too large at %d px\n",
+                     codepoint,
+                     out.pixel_size);
+        return false;
+    }
+
+    out.columns.resize(out.columns.size() + packed_glyph_bytes(glyph.width, glyph.rows));
+    pack_bitmap(bitmap, s_raster, out.columns.data() + glyph.offset);
+    return true;
+}
+
+bool rasterize(FT_Face face, int pixel_size, Size& out)
+{
+    if (FT_Set_Pixel_Sizes(face, 0, pixel_size))
+    {
+        std::fprintf(stderr, "font_atlas: cannot set size %d\n", pixel_size);
+        return false;
+    }
+
+    out.pixel_size = pixel_size;
+    out.ascender = static_cast<int>(face->size->metrics.ascender >> 6);
+    out.line_height = static_cast<int>(face->size->metrics.height >> 6);
+
+    // The charmap yields codepoints in ascending order, as AtlasFont::glyph() expects
+    FT_UInt index = 0;
+    for (FT_ULong cp = FT_Get_First_Char(face, &index); index != 0;
+         cp = FT_Get_Next_Char(face, cp, &index))
+    {
+        if (FT_Load_Char(face, cp, raster_load_flags(s_raster.mode)))
+        {
+            std::fprintf(stderr, "font_atlas: U+%04lX does not render, skipped\n", cp);
+            continue;
+        }
+
+        Glyph glyph;
+        if (!pack(face, static_cast<std::uint32_t>(cp), out, glyph))
+        {
+            return false;
+        }
+        out.glyphs.push_back(glyph);
+    }
+
+    // Every pair of glyphs the font kerns, grid-fitted to this size as FontRenderer does.
+    // Sorted by (left, right) because the glyphs are.
+    if (FT_HAS_KERNING(face))
+    {
+        for (const Glyph& left : out.glyphs)
+        {
+            for (const Glyph& right : out.glyphs)
+            {
+                FT_Vector delta{};
+                FT_Get_Kerning(face,
+                               FT_Get_Char_Index(face, left.codepoint),
+                               FT_Get_Char_Index(face, right.codepoint),
+                               FT_KERNING_DEFAULT,
+                               &delta);
+                const int x = static_cast<int>(delta.x >> 6);
+                if (x != 0)
+                {
+                    out.kerning.push_back(
+                        Kerning{.left = left.codepoint, .right = right.codepoint, .x = x});
+                }
+            }
+        }
+    }
+
+    // Glyph index 0 stands in for characters the font lacks, like FT_Load_Char() does
+    return FT_Load_Glyph(face, 0, raster_load_flags(s_raster.mode)) == 0 &&
+           pack(face, 0, out, out.fallback);
+}
+
+void write_bytes(std::string& text, const std::vector<std::uint8_t>& bytes)
+{
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+    {
+        text += (i % 16 == 0) ? "\n    " : " ";
+        char hex[8];
+        std::snprintf(hex, sizeof(hex), "0x%02X,", bytes[i]);
+        text += hex;
+    }
+    text += "\n";
+}
+
+std::string generate(const std::string& source_name, const std::vector<Size>& sizes)
+{
+    std::string text;
+    text += "// Generated by tools/font_atlas from " + source_name + ". Do not edit.\n\n";
+    text += "#include \"FontAtlas.h\"\n\nnamespace muc::fonts\n{\n\nnamespace\n{\n\n";
+
+    char line[160];
+    for (const Size& size : sizes)
+    {
+        const int px = size.pixel_size;
+
+        std::snprintf(line, sizeof(line), "constexpr std::uint8_t kColumns%d[] = {", px);
+        text += line;
+        write_bytes(text, size.columns);
+        text += "};\n\n";
+
+        std::snprintf(line, sizeof(line), "constexpr std::uint32_t kCodepoints%d[] = {", px);
+        text += line;
+        for (std::size_t i = 0; i < size.glyphs.size(); ++i)
+        {
+            text += (i % 8 == 0) ? "\n    " : " ";
+            std::snprintf(line, sizeof(line), "0x%04X,", size.glyphs[i].codepoint);
+            text += line;
+        }
+        text += "\n};\n\n";
+
+        // {columns, width, rows, left, top, advance}
+        const auto glyph_init = [&](const Glyph& g)
+        {
+            std::snprintf(line,
+                          sizeof(line),
+                          "{kColumns%d + %zu, %d, %d, %d, %d, %d}",
+                          px,
+                          g.offset,
+                          g.width,
+                          g.rows,
+                          g.left,
+                          g.top,
+                          g.advance);
+            return std::string(line);
+        };
+
+        std::snprintf(line, sizeof(line), "constexpr PackedGlyph kGlyphs%d[] = {\n", px);
+        text += line;
+        for (const Glyph& g : size.glyphs)
+        {
+            text += "    " + glyph_init(g) + ",";
+            std::snprintf(line, sizeof(line), " // U+%04X\n", g.codepoint);
+            text += line;
+        }
+        text += "};\n\n";
+
+        // A span can view an empty table, but C++ has no zero-length arrays
+        std::string kerning = "{}";
+        if (!size.kerning.empty())
+        {
+            std::snprintf(line, sizeof(line), "constexpr KerningPair kKerning%d[] = {\n", px);
+            text += line;
+            for (const Kerning& k : size.kerning)
+            {
+                std::snprintf(line,
+                              sizeof(line),
+                              "    {0x%04X, 0x%04X, %d},\n",
+                              k.left,
+                              k.right,
+                              k.x);
+                text += line;
+            }
+            text += "};\n\n";
+            kerning = "kKerning" + std::to_string(px);
+        }
+
+        const std::string fallback = glyph_init(size.fallback);
+        std::snprintf(line,
+                      sizeof(line),
+                      "constexpr AtlasFont kFont%d{%d, %d, %d, kCodepoints%d, kGlyphs%d, %s, "
+                      "%s};\n\n",
+                      px,
+                      px,
+                      size.ascender,
+                      size.line_height,
+                      px,
+                      px,
+                      kerning.c_str(),
+                      fallback.c_str());
+        text += line;
+    }
+
+    text += "constexpr const AtlasFont* kFonts[] = {";
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        std::snprintf(line, sizeof(line), "%s&kFont%d", i ? ", " : "", sizes[i].pixel_size);
+        text += line;
+    }
+    text += "};\n\n} // namespace\n\n";
+    text += "std::span<const AtlasFont* const> atlas_fonts() noexcept\n";
+    text += "{\n    return kFonts;\n}\n\n";
+    text += "} // namespace muc::fonts\n";
+    return text;
+}
+
+// Consumes the leading options; false on an unknown or malformed one
+bool parse_options(int argc, char** argv, int& next)
+{
+    for (next = 1; next + 1 < argc && std::string_view(argv[next]).starts_with("--"); next += 2)
+    {
+        const std::string_view option = argv[next];
+        const std::string_view value = argv[next + 1];
+        if (option == "--raster" && value == "threshold")
+        {
+            s_raster.mode = RasterMode::Threshold;
+        }
+        else if (option == "--raster" && value == "dither")
+        {
+            s_raster.mode = RasterMode::Dither;
+        }
+        else if (option == "--raster" && value == "mono")
+        {
+            s_raster.mode = RasterMode::Mono;
+        }
+        else if (option == "--threshold" && std::atoi(argv[next + 1]) >= 0 &&
+                 std::atoi(argv[next + 1]) <= 255)
+        {
+            s_raster.threshold = static_cast<std::uint8_t>(std::atoi(argv[next + 1]));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int first = 1;
+    if (!parse_options(argc, argv, first) || argc - first < 3)
+    {
+        std::fprintf(stderr,
+                     "usage: %s [--raster threshold|dither|mono] [--threshold <0-255>] "
+                     "<font.ttf> <output.cpp> <pixel size>...\n",
+                     argv[0]);
+        return 2;
+    }
+    const char* font_path = argv[first];
+    const char* output_path = argv[first + 1];
+
+    FT_Library library;
+    FT_Face face;
+    if (FT_Init_FreeType(&library) || FT_New_Face(library, font_path, 0, &face))
+    {
+        std::fprintf(stderr, "font_atlas: cannot open %s\n", font_path);
+        return 1;
+    }
+
+    std::vector<Size> sizes;
+    std::size_t total_bytes = 0;
+    std::size_t total_pairs = 0;
+    for (int i = first + 2; i < argc; ++i)
+    {
+        Size size;
+        if (!rasterize(face, std::atoi(argv[i]), size))
+        {
+            return 1;
+        }
+        total_bytes += size.columns.size();
+        total_pairs += size.kerning.size();
+        sizes.push_back(std::move(size));
+    }
+
+    const std::string path = font_path;
+    const std::string text = generate(path.substr(path.find_last_of("/\\") + 1), sizes);
+    std::ofstream out(output_path, std::ios::binary);
+    if (!out.write(text.data(), static_cast<std::streamsize>(text.size())))
+    {
+        std::fprintf(stderr, "font_atlas: cannot write %s\n", output_path);
+        return 1;
+    }
+
+    std::printf("font_atlas: %zu sizes, %zu glyph bytes, %zu kerning pairs -> %s\n",
+                sizes.size(),
+                total_bytes,
+                total_pairs,
+                output_path);
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+    return 0;
+}
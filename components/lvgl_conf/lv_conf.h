@@ -0,0 +1,300 @@
+/**
+ * LVGL configuration for the 72×40 monochrome SSD1306 target (LVGL v9.5).
+ *
+ * Everything not listed here falls back to lv_conf_internal.h. Because the ESP-IDF
+ * build also feeds Kconfig values into LVGL, every option we care about is set
+ * explicitly so that sdkconfig cannot silently re-enable it.
+ */
+
+/* clang-format off */
+#if 1 /* Set this to "1" to enable content */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/*====================
+   COLOR SETTINGS
+ *====================*/
+
+/* The panel is 1 bit per pixel; render natively in LV_COLOR_FORMAT_I1. */
+#define LV_COLOR_DEPTH 1
+
+/*=========================
+   STDLIB WRAPPER SETTINGS
+ *=========================*/
+
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_STRING    LV_STDLIB_BUILTIN
+#define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
+
+/* Static TLSF arena in .bss (LV_MEM_ADR == 0), never expanded at runtime.
+ *
+ * Size: measured peak + 25% for fragmentation. The peak is "Max Used" in the
+ * "LVGL Heap" block of the CPU_MON log, or the "# arena" line host/ui_host
+ * prints after each scenario (every screen is prebuilt, so one run covers the
+ * final UI; host pointers are 8 bytes, so that peak is an upper bound).
+ * "ui_host --max-arena-pct 80" fails once the peak passes 80% of this value.
+ *
+ * NOT MEASURED YET: no target or LVGL checkout was available when this was
+ * set, so 14 KB is the estimate below + 25%. Replace it with the measured
+ * peak + 25% and record the peak here.
+ *   - display + 4 layer screens + default theme styles      ~ 4.5 KB
+ *   - counter/status labels, QR image object, timers          ~ 1.5 KB
+ *   - draw tasks and a transient simple layer (4 KB, below)   ~ 5.0 KB
+ * The QR pixels and the qrcodegen scratch live in UiQrView's static buffers,
+ * not in this arena. */
+#define LV_MEM_SIZE             (14U * 1024U)
+#define LV_MEM_POOL_EXPAND_SIZE 0
+#define LV_MEM_ADR              0
+
+/*====================
+   HAL SETTINGS
+ *====================*/
+
+/* Initial refresh period only; FrameGovernor (lvgl_driver) owns the real one. */
+#define LV_DEF_REFR_PERIOD  40
+#define LV_DPI_DEF          130
+
+/*=================
+ * OPERATING SYSTEM
+ *=================*/
+
+/* The widget update path is chosen in menuconfig (UI -> Widget update path).
+ * Queue mode: all LVGL calls are made from the lvgl_handler task.
+ * Lock mode:  producers call LVGL directly under lv_lock(); lv_timer_handler()
+ *             takes the same (recursive) mutex for each pass. */
+#if defined(ESP_PLATFORM) && !defined(__ASSEMBLY__)
+    #include "sdkconfig.h"
+#endif
+
+#if defined(CONFIG_UI_UPDATE_MODE_LOCK)
+    #define LV_USE_OS                   LV_OS_FREERTOS
+    #define LV_USE_FREERTOS_TASK_NOTIFY 1
+    /* The SW renderer runs in its own thread once an OS layer is enabled. */
+    #define LV_DRAW_THREAD_STACK_SIZE   (8U * 1024U)
+    #define LV_DRAW_THREAD_PRIO         LV_THREAD_PRIO_HIGH
+#else
+    #define LV_USE_OS   LV_OS_NONE
+#endif
+
+/*========================
+ * RENDERING CONFIGURATION
+ *========================*/
+
+#define LV_DRAW_BUF_STRIDE_ALIGN        1
+#define LV_DRAW_BUF_ALIGN               4
+
+/* A full ARGB8888 layer of the panel is 72*40*4 = 11.5 KB. Simple layers are only
+ * needed for opacity/blend effects, which the UI does not use, so render them in
+ * small chunks instead of reserving the 24 KB default. */
+#define LV_DRAW_LAYER_SIMPLE_BUF_SIZE   (4U * 1024U)
+#define LV_DRAW_LAYER_MAX_MEMORY        0
+
+#define LV_USE_DRAW_SW 1
+#if LV_USE_DRAW_SW == 1
+    /* Keep only the formats that actually reach the blender:
+     *  - I1:       display buffer and the QR image
+     *  - A8:       glyph masks
+     *  - ARGB8888: transparent layers */
+    #define LV_DRAW_SW_SUPPORT_RGB565               0
+    #define LV_DRAW_SW_SUPPORT_RGB565_SWAPPED       0
+    #define LV_DRAW_SW_SUPPORT_RGB565A8             0
+    #define LV_DRAW_SW_SUPPORT_RGB888               0
+    #define LV_DRAW_SW_SUPPORT_XRGB8888             0
+    #define LV_DRAW_SW_SUPPORT_ARGB8888             1
+    #define LV_DRAW_SW_SUPPORT_ARGB8888_PREMULTIPLIED 0
+    #define LV_DRAW_SW_SUPPORT_L8                   0
+    #define LV_DRAW_SW_SUPPORT_AL88                 0
+    #define LV_DRAW_SW_SUPPORT_A8                   1
+    #define LV_DRAW_SW_SUPPORT_I1                   1
+
+    #define LV_DRAW_SW_I1_LUM_THRESHOLD 127
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #define LV_USE_DRAW_ARM2D_SYNC      0
+    #define LV_USE_NATIVE_HELIUM_ASM    0
+
+    #define LV_DRAW_SW_COMPLEX          1
+    #if LV_DRAW_SW_COMPLEX == 1
+        /* No shadows; only a couple of rounded corners from the default theme. */
+        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 2
+    #endif
+
+    #define LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS 0
+#endif
+
+#define LV_USE_VECTOR_GRAPHIC 0
+
+/*=======================
+ * FEATURE CONFIGURATION
+ *=======================*/
+
+#define LV_USE_LOG 0
+
+#define LV_USE_ASSERT_NULL          1
+#define LV_USE_ASSERT_MALLOC        1
+#define LV_USE_ASSERT_STYLE         0
+#define LV_USE_ASSERT_MEM_INTEGRITY 0
+#define LV_USE_ASSERT_OBJ           0
+
+#define LV_USE_REFR_DEBUG           0
+#define LV_USE_LAYER_DEBUG          0
+#define LV_USE_PARALLEL_DRAW_DEBUG  0
+
+/* No decoded images worth caching: the only image source is UiQrView's I1
+ * buffer, which LVGL blits as is. */
+#define LV_CACHE_DEF_SIZE               0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT   0
+
+#define LV_GRADIENT_MAX_STOPS   2
+#define LV_COLOR_MIX_ROUND_OFS  128
+#define LV_OBJ_STYLE_CACHE      0
+#define LV_USE_OBJ_ID           0
+#define LV_USE_OBJ_NAME         0
+#define LV_USE_OBJ_PROPERTY     0
+#define LV_USE_FLOAT            0
+#define LV_USE_MATRIX           0
+
+/*==================
+ *   FONT USAGE
+ *===================*/
+
+/* Montserrat 12 is the only built-in font on screen. Glyph lookups in
+ * lv_font_fmt_txt are served by its last-glyph cache, which is enough for the
+ * short numeric and IP strings we render. */
+#define LV_FONT_MONTSERRAT_8    0
+#define LV_FONT_MONTSERRAT_10   0
+#define LV_FONT_MONTSERRAT_12   1
+#define LV_FONT_MONTSERRAT_14   0
+#define LV_FONT_MONTSERRAT_16   0
+#define LV_FONT_UNSCII_8        0
+#define LV_FONT_UNSCII_16       0
+
+#define LV_FONT_DEFAULT &lv_font_montserrat_12
+
+#define LV_FONT_FMT_TXT_LARGE       0
+#define LV_USE_FONT_COMPRESSED      0
+#define LV_USE_FONT_PLACEHOLDER     1
+
+/*=================
+ *  TEXT SETTINGS
+ *=================*/
+
+#define LV_TXT_ENC LV_TXT_ENC_UTF8
+#define LV_TXT_BREAK_CHARS " ,.;:-_)}"
+#define LV_TXT_LINE_BREAK_LONG_LEN 0
+#define LV_USE_BIDI 0
+#define LV_USE_ARABIC_PERSIAN_CHARS 0
+
+/*==================
+ * WIDGETS
+ *================*/
+
+#define LV_WIDGETS_HAS_DEFAULT_VALUE 0
+
+/* Used: labels and the QR image. No canvas is ever created, but lv_qrcode.c
+ * (compiled for its qrcodegen encoder, see LV_USE_QRCODE) derives its class from
+ * lv_canvas_class, so LV_USE_CANVAS has to stay on; it costs flash, not arena. */
+#define LV_USE_LABEL        1
+#if LV_USE_LABEL
+    #define LV_LABEL_TEXT_SELECTION 0
+    #define LV_LABEL_LONG_TXT_HINT  0
+    #define LV_LABEL_WAIT_CHAR_COUNT 3
+#endif
+#define LV_USE_CANVAS       1
+#define LV_USE_IMAGE        1
+
+#define LV_USE_ANIMIMG      0
+#define LV_USE_ARC          0
+#define LV_USE_ARCLABEL     0
+#define LV_USE_BAR          0
+#define LV_USE_BUTTON       0
+#define LV_USE_BUTTONMATRIX 0
+#define LV_USE_CALENDAR     0
+#define LV_USE_CHART        0
+#define LV_USE_CHECKBOX     0
+#define LV_USE_DROPDOWN     0
+#define LV_USE_IMAGEBUTTON  0
+#define LV_USE_KEYBOARD     0
+#define LV_USE_LED          0
+#define LV_USE_LINE         0
+#define LV_USE_LIST         0
+#define LV_USE_LOTTIE       0
+#define LV_USE_MENU         0
+#define LV_USE_MSGBOX       0
+#define LV_USE_ROLLER       0
+#define LV_USE_SCALE        0
+#define LV_USE_SLIDER       0
+#define LV_USE_SPAN         0
+#define LV_USE_SPINBOX      0
+#define LV_USE_SPINNER      0
+#define LV_USE_SWITCH       0
+#define LV_USE_TEXTAREA     0
+#define LV_USE_TABLE        0
+#define LV_USE_TABVIEW      0
+#define LV_USE_TILEVIEW     0
+#define LV_USE_WIN          0
+
+/*==================
+ * THEMES
+ *==================*/
+
+#define LV_USE_THEME_DEFAULT 1
+#if LV_USE_THEME_DEFAULT
+    #define LV_THEME_DEFAULT_DARK 0
+    #define LV_THEME_DEFAULT_GROW 0
+    #define LV_THEME_DEFAULT_TRANSITION_TIME 0
+#endif
+#define LV_USE_THEME_SIMPLE 0
+#define LV_USE_THEME_MONO   0
+
+/*==================
+ * LAYOUTS
+ *==================*/
+
+#define LV_USE_FLEX 0
+#define LV_USE_GRID 0
+
+/*====================
+ * 3RD PARTS LIBRARIES
+ *====================*/
+
+#define LV_USE_QRCODE   1   /* only its qrcodegen encoder is used (muc::ui::UiQrView) */
+#define LV_USE_BARCODE  0
+#define LV_USE_FREETYPE 0
+#define LV_USE_TINY_TTF 0
+#define LV_USE_LODEPNG  0
+#define LV_USE_BMP      0
+#define LV_USE_GIF      0
+#define LV_USE_RLE      0
+
+/*==================
+ * OTHERS
+ *==================*/
+
+#define LV_USE_SNAPSHOT     0
+#define LV_USE_SYSMON       0
+#define LV_USE_PROFILER     0
+#define LV_USE_MONKEY       0
+#define LV_USE_GRIDNAV      0
+#define LV_USE_FRAGMENT     0
+#define LV_USE_IMGFONT      0
+#define LV_USE_OBSERVER     0
+#define LV_USE_IME_PINYIN   0
+#define LV_USE_FILE_EXPLORER 0
+#define LV_USE_FONT_MANAGER 0
+#define LV_USE_TRANSLATION  0
+#define LV_USE_XML          0
+
+/*==================
+ * EXAMPLES / DEMOS
+ *==================*/
+
+#define LV_BUILD_EXAMPLES 0
+#define LV_BUILD_DEMOS    0
+
+#endif /* LV_CONF_H */
+
+#endif /* End of "Content enable" */
+/* clang-format on */
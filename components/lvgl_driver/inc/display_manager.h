@@ -0,0 +1,69 @@
+#ifndef COMPONENT_LVGL_DRIVER_DISPLAY_MANAGER_H
+#define COMPONENT_LVGL_DRIVER_DISPLAY_MANAGER_H
+
+#include <array>
+#include <cstddef>
+
+#include "lvgl.h"
+#include "lvgl_display.h"
+
+namespace muc::lvgl_driver
+{
+
+// SSD1306 supports two addresses per bus (0x3C / 0x3D)
+constexpr std::size_t kMaxDisplays = 2;
+
+// Owns the bus transfers of several panels sharing one I2C bus.
+//
+// With a single panel, its flush sends the frame right away, as without a manager.
+// With more, flushes only copy LVGL's frame into the panel framebuffer and a single
+// LVGL timer then pushes all pending frames page by page, alternating between panels
+// (A0 B0 A1 B1 ...). All panels are still sent back to back from the LVGL task, so
+// this does not shorten a refresh: it only leaves the bus free between page writes for
+// other bus users, instead of holding it for a whole frame. Each panel's FrameGovernor
+// counts the batch's bus time in that frame (transfer_done()).
+class DisplayManager
+{
+  public:
+    DisplayManager() noexcept;
+
+    DisplayManager(const DisplayManager&) = delete;
+    DisplayManager& operator=(const DisplayManager&) = delete;
+
+    // Initializes the display and takes over its bus transfers. The first display
+    // added becomes LVGL's default display.
+    bool add(LvglDisplay& display) noexcept;
+
+    std::size_t size() const noexcept
+    {
+        return m_count;
+    }
+
+    LvglDisplay* display(std::size_t index) const noexcept
+    {
+        return index < m_count ? m_displays[index] : nullptr;
+    }
+
+  private:
+    friend class LvglDisplay;
+
+    // Whether flushes leave the bus transfer to the manager (more than one panel)
+    bool batches_transfers() const noexcept
+    {
+        return m_count > 1;
+    }
+
+    // Called from a flush callback (LVGL context)
+    void request_transfer() noexcept;
+
+    static void transfer_cb(lv_timer_t* timer);
+    void transfer_pending() noexcept;
+
+    std::array<LvglDisplay*, kMaxDisplays> m_displays;
+    std::size_t m_count;
+    lv_timer_t* m_transfer_timer;
+};
+
+} // namespace muc::lvgl_driver
+
+#endif // COMPONENT_LVGL_DRIVER_DISPLAY_MANAGER_H
@@ -0,0 +1,95 @@
+#ifndef COMPONENT_LVGL_DRIVER_FRAME_GOVERNOR_H
+#define COMPONENT_LVGL_DRIVER_FRAME_GOVERNOR_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "lvgl.h"
+
+namespace muc::lvgl_driver
+{
+
+// Refresh cap while something is animating or being invalidated
+constexpr std::uint32_t kDefaultTargetFps = 25;
+
+// Upper bounds (ms) of the frame-time histogram buckets; the last bucket is open-ended
+constexpr std::array<std::uint32_t, 5> kFrameTimeBucketMs = {5, 10, 20, 40, 80};
+constexpr std::size_t kFrameTimeBuckets = kFrameTimeBucketMs.size() + 1;
+
+struct FrameStats
+{
+    std::uint32_t target_fps;
+    std::uint32_t achieved_fps; // over the last measurement window, 0 while idle
+    std::uint32_t frames;       // frames rendered and flushed since boot
+    std::uint32_t dropped;      // refresh slots missed because a frame overran its budget
+    std::uint32_t idle_periods; // transitions into the paused (zero refresh) state
+    std::uint32_t max_frame_us;
+    bool idle;
+    std::array<std::uint32_t, kFrameTimeBuckets> frame_time_hist;
+};
+
+// Adaptive refresh-rate governor for one LVGL display.
+//
+// While objects are invalidated or animations run, the display refresh timer runs at
+// target_fps. As soon as a refresh cycle finds nothing to draw, the refresh timer is
+// paused, so LVGL stops waking up for the display at all; the next invalidation
+// resumes it. All callbacks run inside lv_timer_handler().
+//
+// A frame lasts from the start of rendering until the panel has it: the flush sends it
+// over the bus, or, when DisplayManager batches the transfers of several panels, the
+// frame is recorded once transfer_done() reports the batch.
+class FrameGovernor
+{
+  public:
+    explicit FrameGovernor(std::uint32_t target_fps = kDefaultTargetFps) noexcept;
+
+    FrameGovernor(const FrameGovernor&) = delete;
+    FrameGovernor& operator=(const FrameGovernor&) = delete;
+
+    void attach(lv_display_t& disp) noexcept;
+
+    // Must be called from the LVGL context
+    void set_target_fps(std::uint32_t fps) noexcept;
+
+    // Safe to call from any task
+    FrameStats stats() const noexcept;
+
+    // LVGL context. While deferred, a rendered frame is only recorded by the next
+    // transfer_done(), with the bus time of that transfer added.
+    void set_deferred_transfer(bool deferred) noexcept;
+    void transfer_done(std::uint32_t transfer_us) noexcept;
+
+  private:
+    static void event_cb(lv_event_t* e);
+
+    void on_refresh_start() noexcept;
+    void on_render_start() noexcept;
+    void on_refresh_ready() noexcept;
+    void on_invalidate() noexcept;
+
+    void record_frame(std::uint32_t frame_us) noexcept;
+    void enter_idle() noexcept;
+
+    lv_timer_t* m_refr_timer;
+    std::uint32_t m_period_us;
+
+    // LVGL-context state; m_stats mirrors it for other tasks
+    bool m_idle;
+    bool m_rendering;
+    std::int64_t m_render_start_us;
+
+    bool m_deferred_transfer;
+    bool m_frame_pending;
+    std::uint32_t m_pending_frame_us;
+
+    std::int64_t m_window_start_us;
+    std::uint32_t m_window_frames;
+
+    mutable std::mutex m_stats_mutex;
+    FrameStats m_stats;
+};
+
+} // namespace muc::lvgl_driver
+
+#endif // COMPONENT_LVGL_DRIVER_FRAME_GOVERNOR_H
@@ -0,0 +1,67 @@
+#ifndef COMPONENT_LVGL_DRIVER_LVGL_DISPLAY_H
+#define COMPONENT_LVGL_DRIVER_LVGL_DISPLAY_H
+
+#include <cstdint>
+#include <span>
+
+#include "frame_governor.h"
+#include "lvgl.h"
+#include "ssd1306.h"
+
+namespace muc::lvgl_driver
+{
+
+class DisplayManager;
+
+// One LVGL display bound to one SSD1306 panel.
+//
+// The draw buffer is owned by the caller (usually a static array sized with
+// muc::ssd1306::lvgl_buffer_bytes()) so that every panel can have its own geometry.
+class LvglDisplay
+{
+  public:
+    LvglDisplay(muc::ssd1306::Oled& oled,
+                std::span<std::uint8_t> draw_buffer,
+                std::uint32_t target_fps = kDefaultTargetFps) noexcept;
+
+    LvglDisplay(const LvglDisplay&) = delete;
+    LvglDisplay& operator=(const LvglDisplay&) = delete;
+
+    // Creates the lv_display_t; lvgl_driver_init() must have run first
+    bool init() noexcept;
+
+    lv_display_t* display() const noexcept
+    {
+        return m_disp;
+    }
+
+    muc::ssd1306::Oled& oled() noexcept
+    {
+        return m_oled;
+    }
+
+    FrameGovernor& governor() noexcept
+    {
+        return m_governor;
+    }
+
+  private:
+    friend class DisplayManager;
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t* area, std::uint8_t* color_p);
+
+    muc::ssd1306::Oled& m_oled;
+    std::span<std::uint8_t> m_buffer;
+    lv_draw_buf_t m_draw_buf;
+    lv_display_t* m_disp;
+    FrameGovernor m_governor;
+
+    // Set when a DisplayManager owns this panel; with several panels it does the bus
+    // transfers
+    DisplayManager* m_manager;
+    bool m_transfer_pending;
+};
+
+} // namespace muc::lvgl_driver
+
+#endif // COMPONENT_LVGL_DRIVER_LVGL_DISPLAY_H
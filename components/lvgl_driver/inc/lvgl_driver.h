@@ -3,16 +3,38 @@
 
 #include <cstdint>
 
+#include "display_manager.h"
+#include "frame_governor.h"
 #include "lvgl.h"
-#include "ssd1306.h"
+#include "lvgl_display.h"
 
 namespace muc::lvgl_driver
 {
 
 constexpr bool ENABLE_HANDLE_TEST = false;
 
-void lvgl_driver_init(muc::ssd1306::Oled& oled);
+// How often the LVGL arena is sampled from inside the LVGL context
+constexpr std::uint32_t kMemorySamplePeriodMs = 1000;
+
+// Snapshot of the LVGL builtin (TLSF) arena, see LV_MEM_SIZE in lv_conf.h
+struct MemoryStats
+{
+    std::uint32_t total_bytes;
+    std::uint32_t free_bytes;
+    std::uint32_t max_used_bytes; // high-water mark since boot
+    std::uint32_t largest_free_block;
+    std::uint8_t used_pct;
+    std::uint8_t frag_pct;
+};
+
+// Initializes LVGL itself; panels are added afterwards through display_manager()
+void lvgl_driver_init();
+
+DisplayManager& display_manager() noexcept;
+
+// Safe to call from any task: returns the last sample taken by the LVGL timer
+MemoryStats memory_stats() noexcept;
 
 } // namespace muc::lvgl_driver
 
-#endif //
+#endif // COMPONENT_LVGL_DRIVER_H
@@ -0,0 +1,111 @@
+#include "display_manager.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+#include <esp_timer.h>
+
+namespace muc::lvgl_driver
+{
+
+DisplayManager::DisplayManager() noexcept
+: m_displays{}
+, m_count(0)
+, m_transfer_timer(nullptr)
+{
+}
+
+bool DisplayManager::add(LvglDisplay& display) noexcept
+{
+    if (m_count >= m_displays.size())
+    {
+        std::printf("[LVGL][ERR] Display manager full (%zu panels)\n", m_displays.size());
+        return false;
+    }
+
+    if (!display.init())
+    {
+        return false;
+    }
+
+    if (m_count == 0)
+    {
+        lv_display_set_default(display.display());
+    }
+
+    display.m_manager = this;
+    m_displays[m_count++] = &display;
+
+    if (batches_transfers())
+    {
+        if (!m_transfer_timer)
+        {
+            // Idle until a flush requests a transfer
+            m_transfer_timer = lv_timer_create(transfer_cb, 1, this);
+            lv_timer_pause(m_transfer_timer);
+        }
+
+        // Frames now end in transfer_pending()
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            m_displays[i]->m_governor.set_deferred_transfer(true);
+        }
+    }
+    return true;
+}
+
+void DisplayManager::request_transfer() noexcept
+{
+    lv_timer_resume(m_transfer_timer);
+    lv_timer_ready(m_transfer_timer);
+}
+
+void DisplayManager::transfer_cb(lv_timer_t* timer)
+{
+    auto* self = static_cast<DisplayManager*>(lv_timer_get_user_data(timer));
+    self->transfer_pending();
+    lv_timer_pause(timer);
+}
+
+// -----------------------------------------------------------------------------
+// Page-interleaved transfer of every panel with a new frame
+// -----------------------------------------------------------------------------
+void DisplayManager::transfer_pending() noexcept
+{
+    const std::int64_t start_us = esp_timer_get_time();
+    int max_pages = 0;
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        if (m_displays[i]->m_transfer_pending)
+        {
+            max_pages = std::max(max_pages, m_displays[i]->m_oled.page_count());
+        }
+    }
+
+    for (int page = 0; page < max_pages; ++page)
+    {
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            LvglDisplay& d = *m_displays[i];
+            if (d.m_transfer_pending && page < d.m_oled.page_count())
+            {
+                d.m_oled.update_page(page);
+            }
+        }
+    }
+
+    // Interleaved, every panel's frame is complete only at the end of the batch
+    const auto transfer_us = static_cast<std::uint32_t>(esp_timer_get_time() - start_us);
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        LvglDisplay& d = *m_displays[i];
+        if (d.m_transfer_pending)
+        {
+            d.m_transfer_pending = false;
+            d.m_governor.transfer_done(transfer_us);
+        }
+    }
+}
+
+} // namespace muc::lvgl_driver
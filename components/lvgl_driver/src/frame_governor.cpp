@@ -0,0 +1,221 @@
+#include "frame_governor.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <esp_timer.h>
+
+namespace muc::lvgl_driver
+{
+
+namespace
+{
+constexpr std::int64_t kFpsWindowUs = 1000 * 1000;
+
+std::uint32_t period_us_for(std::uint32_t fps)
+{
+    return 1000000U / std::max<std::uint32_t>(fps, 1U);
+}
+} // namespace
+
+FrameGovernor::FrameGovernor(std::uint32_t target_fps) noexcept
+: m_refr_timer(nullptr)
+, m_period_us(period_us_for(target_fps))
+, m_idle(false)
+, m_rendering(false)
+, m_render_start_us(0)
+, m_deferred_transfer(false)
+, m_frame_pending(false)
+, m_pending_frame_us(0)
+, m_window_start_us(0)
+, m_window_frames(0)
+, m_stats_mutex()
+, m_stats{}
+{
+    m_stats.target_fps = target_fps;
+}
+
+void FrameGovernor::attach(lv_display_t& disp) noexcept
+{
+    m_refr_timer = lv_display_get_refr_timer(&disp);
+    m_window_start_us = esp_timer_get_time();
+    lv_display_add_event_cb(&disp, event_cb, LV_EVENT_ALL, this);
+    set_target_fps(m_stats.target_fps);
+}
+
+void FrameGovernor::set_target_fps(std::uint32_t fps) noexcept
+{
+    fps = std::max<std::uint32_t>(fps, 1U);
+    m_period_us = period_us_for(fps);
+
+    if (m_refr_timer)
+    {
+        lv_timer_set_period(m_refr_timer, m_period_us / 1000U);
+    }
+
+    std::lock_guard<std::mutex> guard(m_stats_mutex);
+    m_stats.target_fps = fps;
+}
+
+FrameStats FrameGovernor::stats() const noexcept
+{
+    std::lock_guard<std::mutex> guard(m_stats_mutex);
+    return m_stats;
+}
+
+void FrameGovernor::set_deferred_transfer(bool deferred) noexcept
+{
+    m_deferred_transfer = deferred;
+}
+
+void FrameGovernor::transfer_done(std::uint32_t transfer_us) noexcept
+{
+    if (m_frame_pending)
+    {
+        m_frame_pending = false;
+        record_frame(m_pending_frame_us + transfer_us);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// LVGL display events
+// -----------------------------------------------------------------------------
+void FrameGovernor::event_cb(lv_event_t* e)
+{
+    auto* self = static_cast<FrameGovernor*>(lv_event_get_user_data(e));
+
+    switch (lv_event_get_code(e))
+    {
+    case LV_EVENT_INVALIDATE_AREA:
+        self->on_invalidate();
+        break;
+    case LV_EVENT_REFR_START:
+        self->on_refresh_start();
+        break;
+    case LV_EVENT_RENDER_START:
+        self->on_render_start();
+        break;
+    case LV_EVENT_REFR_READY:
+        self->on_refresh_ready();
+        break;
+    default:
+        break;
+    }
+}
+
+void FrameGovernor::on_refresh_start() noexcept
+{
+    m_rendering = false;
+}
+
+void FrameGovernor::on_render_start() noexcept
+{
+    // Full render mode: one render per refresh, so the first start marks the frame
+    if (!m_rendering)
+    {
+        m_rendering = true;
+        m_render_start_us = esp_timer_get_time();
+    }
+}
+
+void FrameGovernor::on_refresh_ready() noexcept
+{
+    if (m_rendering)
+    {
+        m_rendering = false;
+        const auto frame_us =
+            static_cast<std::uint32_t>(esp_timer_get_time() - m_render_start_us);
+        if (m_deferred_transfer)
+        {
+            m_pending_frame_us = frame_us;
+            m_frame_pending = true;
+        }
+        else
+        {
+            record_frame(frame_us);
+        }
+        return;
+    }
+
+    // Nothing was invalidated during a whole refresh period
+    if (lv_anim_count_running() == 0)
+    {
+        enter_idle();
+    }
+}
+
+void FrameGovernor::on_invalidate() noexcept
+{
+    if (!m_idle)
+    {
+        return;
+    }
+
+    m_idle = false;
+    if (m_refr_timer)
+    {
+        lv_timer_resume(m_refr_timer);
+    }
+
+    m_window_start_us = esp_timer_get_time();
+    m_window_frames = 0;
+
+    std::lock_guard<std::mutex> guard(m_stats_mutex);
+    m_stats.idle = false;
+}
+
+// -----------------------------------------------------------------------------
+// Accounting
+// -----------------------------------------------------------------------------
+void FrameGovernor::record_frame(std::uint32_t frame_us) noexcept
+{
+    const std::int64_t now = esp_timer_get_time();
+
+    const std::uint32_t frame_ms = frame_us / 1000U;
+    const auto bucket = static_cast<std::size_t>(
+        std::upper_bound(kFrameTimeBucketMs.begin(), kFrameTimeBucketMs.end(), frame_ms) -
+        kFrameTimeBucketMs.begin());
+
+    std::lock_guard<std::mutex> guard(m_stats_mutex);
+
+    m_stats.frames++;
+    m_stats.frame_time_hist[bucket]++;
+    m_stats.max_frame_us = std::max(m_stats.max_frame_us, frame_us);
+
+    // A frame longer than its budget pushes every following slot it overlaps
+    if (frame_us > m_period_us)
+    {
+        m_stats.dropped += frame_us / m_period_us;
+    }
+
+    m_window_frames++;
+    const std::int64_t elapsed = now - m_window_start_us;
+    if (elapsed >= kFpsWindowUs)
+    {
+        m_stats.achieved_fps = static_cast<std::uint32_t>(
+            (static_cast<std::int64_t>(m_window_frames) * 1000000 + elapsed / 2) / elapsed);
+        m_window_start_us = now;
+        m_window_frames = 0;
+    }
+}
+
+void FrameGovernor::enter_idle() noexcept
+{
+    if (m_idle)
+    {
+        return;
+    }
+
+    m_idle = true;
+    if (m_refr_timer)
+    {
+        lv_timer_pause(m_refr_timer);
+    }
+
+    std::lock_guard<std::mutex> guard(m_stats_mutex);
+    m_stats.idle = true;
+    m_stats.idle_periods++;
+    m_stats.achieved_fps = 0;
+}
+
+} // namespace muc::lvgl_driver
@@ -0,0 +1,128 @@
+#include "lvgl_display.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "display_geometry.h"
+#include "display_manager.h"
+#include "lvgl_driver.h"
+
+namespace muc::lvgl_driver
+{
+
+using muc::ssd1306::framebuffer_bytes;
+using muc::ssd1306::lvgl_buffer_bytes;
+
+LvglDisplay::LvglDisplay(muc::ssd1306::Oled& oled,
+                         std::span<std::uint8_t> draw_buffer,
+                         std::uint32_t target_fps) noexcept
+: m_oled(oled)
+, m_buffer(draw_buffer)
+, m_draw_buf{}
+, m_disp(nullptr)
+, m_governor(target_fps)
+, m_manager(nullptr)
+, m_transfer_pending(false)
+{
+}
+
+// -----------------------------------------------------------------------------
+// LVGL flush callback (I1 format)
+// -----------------------------------------------------------------------------
+void LvglDisplay::flush_cb(lv_display_t* disp, const lv_area_t*, std::uint8_t* color_p)
+{
+    auto* self = static_cast<LvglDisplay*>(lv_display_get_user_data(disp));
+    if (!self)
+    {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    const auto& g = self->m_oled.geometry();
+    const std::uint8_t* src = color_p + 8; // skip palette
+    self->m_oled.blitLVGLBuffer(std::span<const std::uint8_t>(src, framebuffer_bytes(g)));
+
+    // The frame now lives in the panel's own framebuffer, so LVGL may reuse its buffer
+    // right away. With several panels the manager batches their bus transfers.
+    if (self->m_manager && self->m_manager->batches_transfers())
+    {
+        self->m_transfer_pending = true;
+        self->m_manager->request_transfer();
+    }
+    else
+    {
+        self->m_oled.update();
+    }
+
+    lv_display_flush_ready(disp);
+}
+
+// -----------------------------------------------------------------------------
+// LVGL display initialization
+// -----------------------------------------------------------------------------
+bool LvglDisplay::init() noexcept
+{
+    const auto& g = m_oled.geometry();
+    const std::size_t needed = lvgl_buffer_bytes(g);
+
+    if (m_buffer.size() < needed)
+    {
+        std::printf("[LVGL][ERR] Draw buffer too small for %dx%d: got %zu, need %zu\n",
+                    g.width,
+                    g.height,
+                    m_buffer.size(),
+                    needed);
+        return false;
+    }
+
+    if constexpr (ENABLE_HANDLE_TEST)
+    {
+        std::array<std::uint8_t, muc::ssd1306::SSD1306_WIDTH * muc::ssd1306::SSD1306_PAGES> test{};
+        const auto visible = std::span<std::uint8_t>(test).first(framebuffer_bytes(g));
+
+        std::fill(visible.begin(), visible.end(), 0xFF);
+        m_oled.blitLVGLBuffer(visible);
+        m_oled.update();
+        vTaskDelay(pdMS_TO_TICKS(200));
+
+        std::fill(visible.begin(), visible.end(), 0x00);
+        m_oled.blitLVGLBuffer(visible);
+        m_oled.update();
+        vTaskDelay(pdMS_TO_TICKS(200));
+    }
+
+    m_disp = lv_display_create(g.width, g.height);
+    // Force full-frame rendering, no partial flushes
+    lv_display_set_render_mode(m_disp, LV_DISPLAY_RENDER_MODE_FULL);
+
+    // Initialize LVGL draw buffers
+    lv_draw_buf_init(&m_draw_buf,
+                     g.width,
+                     g.height,
+                     LV_COLOR_FORMAT_I1,
+                     0,
+                     m_buffer.data(),
+                     static_cast<std::uint32_t>(needed));
+
+    lv_display_set_draw_buffers(m_disp, &m_draw_buf, nullptr);
+    lv_display_set_color_format(m_disp, LV_COLOR_FORMAT_I1);
+    lv_display_set_flush_cb(m_disp, flush_cb);
+    lv_display_set_user_data(m_disp, this);
+
+    m_governor.attach(*m_disp);
+
+    std::printf("[LVGL] Display ready (%dx%d, LVGL buf=%zu, FB=%zu)\n",
+                g.width,
+                g.height,
+                needed,
+                framebuffer_bytes(g));
+    return true;
+}
+
+} // namespace muc::lvgl_driver
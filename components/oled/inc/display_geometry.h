@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_OLED_INC_DISPLAY_GEOMETRY_H
 #define COMPONENTS_OLED_INC_DISPLAY_GEOMETRY_H
 
+#include <cstddef>
 #include <cstdint>
 
 namespace muc::ssd1306
@@ -27,13 +28,20 @@ constexpr DisplayGeometry kDefaultGeometry{.width = 72,
                                            .ram_height = 64,
                                            .ram_pages = 64 / 8};
 
-// Visible framebuffer bytes (LVGL draws only this window)
-constexpr std::size_t kVisibleFramebufferBytes = static_cast<std::size_t>(kDefaultGeometry.width) *
-                                                 static_cast<std::size_t>(kDefaultGeometry.height) /
-                                                 8;
+// Visible framebuffer bytes of a panel (LVGL draws only this window)
+constexpr std::size_t framebuffer_bytes(const DisplayGeometry& g)
+{
+    return static_cast<std::size_t>(g.width) * static_cast<std::size_t>(g.height) / 8;
+}
 
 // LVGL I1 buffer = 8‑byte palette + framebuffer
-constexpr std::size_t kVisibleLvglBufferBytes = 8 + kVisibleFramebufferBytes;
+constexpr std::size_t lvgl_buffer_bytes(const DisplayGeometry& g)
+{
+    return 8 + framebuffer_bytes(g);
+}
+
+constexpr std::size_t kVisibleFramebufferBytes = framebuffer_bytes(kDefaultGeometry);
+constexpr std::size_t kVisibleLvglBufferBytes = lvgl_buffer_bytes(kDefaultGeometry);
 
 // Full SSD1306 RAM buffer (chip-level)
 constexpr std::size_t kRamBufferBytes = static_cast<std::size_t>(kDefaultGeometry.ram_width) *
@@ -23,6 +23,8 @@ constexpr std::size_t SSD1306_HEIGHT = 64;
 constexpr std::size_t SSD1306_PAGES = SSD1306_HEIGHT / 8;
 
 constexpr std::uint8_t OLED_ADDR = 0x3C;
+// Second panel on the same bus (SA0 pulled high)
+constexpr std::uint8_t OLED_ADDR_SECONDARY = 0x3D;
 
 class Oled
 {
@@ -37,9 +39,27 @@ class Oled
     void clear() noexcept;
     void drawPixel(int x, int y, bool on) noexcept;
 
+    // Visible window of the local framebuffer for direct drawing: one strip of `width`
+    // bytes per 8-row page, pixel (x, y) at bit y % 8 of byte (y / 8) * width + x
+    std::span<std::uint8_t> framebuffer() noexcept
+    {
+        const auto pages = static_cast<std::size_t>((m_geometry.height + 7) / 8);
+        return std::span<std::uint8_t>(m_screen.data(),
+                                       pages * static_cast<std::size_t>(m_geometry.width));
+    }
+
     // Push local framebuffer to the physical display
     void update() noexcept;
 
+    // Push a single visible page (8 rows); lets several panels share the bus fairly
+    void update_page(int page) noexcept;
+
+    // Number of visible pages, i.e. update_page() calls per full update()
+    int page_count() const noexcept
+    {
+        return m_geometry.height / 8;
+    }
+
     // Read-only access to geometry
     const DisplayGeometry& geometry() const noexcept
     {
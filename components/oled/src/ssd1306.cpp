@@ -200,23 +200,30 @@ void Oled::clear() noexcept
 
 void Oled::update() noexcept
 {
-    int pages = m_geometry.height / 8;
+    for (int p = 0; p < page_count(); ++p)
+    {
+        update_page(p);
+    }
+}
 
-    for (int p = 0; p < pages; ++p)
+void Oled::update_page(int p) noexcept
+{
+    if (p < 0 || p >= page_count())
     {
-        // Physical page in SSD1306 address space (apply Y offset here)
-        std::uint8_t phys_page = static_cast<std::uint8_t>(p + (m_geometry.y_offset / 8));
+        return;
+    }
 
-        // Move column pointer to the start of the visible window (local column 0)
-        setPageColumn(phys_page, 0);
+    // Physical page in SSD1306 address space (apply Y offset here)
+    std::uint8_t phys_page = static_cast<std::uint8_t>(p + (m_geometry.y_offset / 8));
 
-        // Start of this page in m_screen (local width-byte strip)
-        const std::uint8_t* row_ptr = m_screen.data() + (p * m_geometry.width);
+    // Move column pointer to the start of the visible window (local column 0)
+    setPageColumn(phys_page, 0);
 
-        // Send the visible width bytes for this horizontal strip
-        sendData(
-            std::span<const std::uint8_t>(row_ptr, static_cast<std::size_t>(m_geometry.width)));
-    }
+    // Start of this page in m_screen (local width-byte strip)
+    const std::uint8_t* row_ptr = m_screen.data() + (p * m_geometry.width);
+
+    // Send the visible width bytes for this horizontal strip
+    sendData(std::span<const std::uint8_t>(row_ptr, static_cast<std::size_t>(m_geometry.width)));
 }
 
 // =============================================================================
@@ -0,0 +1,308 @@
+#ifndef COMPONENTS_UI_INC_RING_BUFFER_H
+#define COMPONENTS_UI_INC_RING_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace muc::ui
+{
+
+// Indices written by different sides are kept on separate lines. The ESP32-C3 has no
+// data cache, so this only costs a few bytes there; on the host it avoids false sharing.
+constexpr std::size_t kCacheLineBytes = 64;
+
+// -----------------------------------------------------------------------------
+// Single producer, single consumer
+// -----------------------------------------------------------------------------
+// Wait-free on both sides: one acquire load and one release store per operation. Each
+// side keeps a cached copy of the other side's index and only reloads it when the ring
+// looks full (producer) or empty (consumer).
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "items are copied by assignment");
+
+  public:
+    using value_type = T;
+    static constexpr std::size_t kCapacity = Capacity;
+
+    SpscRing() noexcept = default;
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side
+    bool try_push(const T& item) noexcept
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail_cache == Capacity)
+        {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tail_cache == Capacity)
+            {
+                return false;
+            }
+        }
+
+        m_items[head & kMask] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T& out) noexcept
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head_cache)
+        {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail == m_head_cache)
+            {
+                return false;
+            }
+        }
+
+        out = m_items[tail & kMask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently
+    std::size_t size() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    // Producer line
+    alignas(kCacheLineBytes) std::atomic<std::size_t> m_head{0};
+    std::size_t m_tail_cache = 0;
+
+    // Consumer line
+    alignas(kCacheLineBytes) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_head_cache = 0;
+
+    alignas(kCacheLineBytes) std::array<T, Capacity> m_items{};
+};
+
+// -----------------------------------------------------------------------------
+// Multiple producers, single consumer
+// -----------------------------------------------------------------------------
+// Bounded sequence-numbered ring (Vyukov): producers claim a slot with one CAS on the
+// head index and publish it through the slot's sequence number, so a slow producer
+// never blocks the others from claiming. The single consumer needs no atomic RMW.
+// On the ESP32-C3 (RV32IMC, no "A" extension) the CAS is emulated by the toolchain
+// with a short interrupt-masked section; loads and stores stay plain word accesses.
+template <typename T, std::size_t Capacity>
+class MpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "items are copied by assignment");
+
+  public:
+    using value_type = T;
+    static constexpr std::size_t kCapacity = Capacity;
+
+    MpscRing() noexcept
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+        {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Any producer task (or ISR)
+    bool try_push(const T& item) noexcept
+    {
+        std::size_t pos = m_head.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        while (true)
+        {
+            cell = &m_cells[pos & kMask];
+            const std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T& out) noexcept
+    {
+        Cell& cell = m_cells[m_tail & kMask];
+        if (cell.seq.load(std::memory_order_acquire) != m_tail + 1)
+        {
+            return false; // empty, or the next producer has claimed but not published yet
+        }
+
+        out = cell.item;
+        cell.seq.store(m_tail + Capacity, std::memory_order_release);
+        m_tail++;
+        return true;
+    }
+
+  private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    struct Cell
+    {
+        std::atomic<std::size_t> seq;
+        T item;
+    };
+
+    alignas(kCacheLineBytes) std::atomic<std::size_t> m_head{0};
+    alignas(kCacheLineBytes) std::size_t m_tail = 0;
+    alignas(kCacheLineBytes) std::array<Cell, Capacity> m_cells{};
+};
+
+// -----------------------------------------------------------------------------
+// Blocking consumer on top of a ring
+// -----------------------------------------------------------------------------
+// Producers stay on the lock-free path and only pay for xTaskNotifyGive() when the
+// consumer has announced that it is about to block. The consumer re-checks the ring
+// after announcing. That is a store-then-load on two different variables on each side
+// (consumer: m_waiting, then the ring; producer: the ring, then m_waiting), which
+// release/acquire does not order, so both sides put a seq_cst fence between the two:
+// at least one of them then sees the other's store, and a push racing with the
+// announcement is never missed.
+template <typename Ring>
+class NotifyingRing
+{
+  public:
+    using value_type = typename Ring::value_type;
+    static constexpr std::size_t kCapacity = Ring::kCapacity;
+
+    NotifyingRing() noexcept = default;
+
+    NotifyingRing(const NotifyingRing&) = delete;
+    NotifyingRing& operator=(const NotifyingRing&) = delete;
+
+    // Never blocks; false if the ring is full
+    bool send(const value_type& item) noexcept
+    {
+        if (!m_ring.try_push(item))
+        {
+            return false;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting.load(std::memory_order_seq_cst) &&
+            m_waiting.exchange(false, std::memory_order_seq_cst))
+        {
+            xTaskNotifyGive(m_consumer.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    // ISR-safe variant of send(): same lock-free push, FromISR wake-up
+    bool send_from_isr(const value_type& item, BaseType_t* higher_priority_task_woken) noexcept
+    {
+        if (!m_ring.try_push(item))
+        {
+            return false;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting.load(std::memory_order_seq_cst) &&
+            m_waiting.exchange(false, std::memory_order_seq_cst))
+        {
+            vTaskNotifyGiveFromISR(m_consumer.load(std::memory_order_relaxed),
+                                   higher_priority_task_woken);
+        }
+        return true;
+    }
+
+    // Single consumer task. Uses that task's notification value (index 0).
+    bool receive(value_type& out, TickType_t timeout) noexcept
+    {
+        if (m_ring.try_pop(out))
+        {
+            return true;
+        }
+        if (timeout == 0)
+        {
+            return false;
+        }
+
+        m_consumer.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+        const TickType_t start = xTaskGetTickCount();
+        TickType_t remaining = timeout;
+
+        while (true)
+        {
+            m_waiting.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_ring.try_pop(out))
+            {
+                m_waiting.store(false, std::memory_order_relaxed);
+                return true;
+            }
+
+            (void)ulTaskNotifyTake(pdTRUE, remaining);
+            m_waiting.store(false, std::memory_order_seq_cst);
+
+            // A stale notification from an earlier race only costs one extra loop
+            if (m_ring.try_pop(out))
+            {
+                return true;
+            }
+
+            if (timeout != portMAX_DELAY)
+            {
+                const TickType_t elapsed = xTaskGetTickCount() - start;
+                if (elapsed >= timeout)
+                {
+                    return false;
+                }
+                remaining = timeout - elapsed;
+            }
+        }
+    }
+
+    Ring& ring() noexcept
+    {
+        return m_ring;
+    }
+
+  private:
+    Ring m_ring;
+    std::atomic<bool> m_waiting{false};
+    std::atomic<TaskHandle_t> m_consumer{nullptr};
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_RING_BUFFER_H
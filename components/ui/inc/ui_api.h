@@ -1,23 +1,52 @@
 #ifndef COMPONENTS_UI_INC_UI_API_H
 #define COMPONENTS_UI_INC_UI_API_H
 
+#include <cstdint>
 #include <string_view>
 
+#include <freertos/FreeRTOS.h>
+
 #include "ui_queue.h"
+#include "ui_value.h"
 
 namespace muc::ui
 {
 
+// esp_timer time stamped on every UiApi command, task or ISR. Strictly increasing, so
+// it also orders commands submitted within the same microsecond; UiMailbox relies on
+// it to keep the newest value when an ISR command is drained after a later task one.
+std::int64_t ui_submit_time_us() noexcept;
+
+// Producer-side UI interface. Depending on CONFIG_UI_UPDATE_MODE the commands are
+// either queued for the lvgl_handler task or applied directly under the LVGL lock.
+// Text and status are truncated to 127 bytes and QR payloads to 160 (kMailboxSlotBytes).
+// set_text() and set_number() both write the counter label; the later call wins.
 class UiApi
 {
   public:
     explicit UiApi(muc::ui::UiQueue& queue);
 
     void set_text(std::string_view text);
+    // Typed counter updates: the raw value is queued and formatted by lvgl_handler,
+    // only when it changed. set_fixed() shows raw / 10^decimals ("{}" -> "21.5").
+    void set_number(std::int32_t value, UiFormat format = "{}");
+    void set_fixed(std::int32_t raw, std::uint8_t decimals, UiFormat format = "{}");
     void set_status(std::string_view status);
     void show_provision_qr(std::string_view payload);
 
+    // ISR variants: bounded time, no locks and no mailbox. The command goes straight
+    // into UiQueue (payload capped at kUiIsrMaxPayloadBytes) and is coalesced by
+    // lvgl_handler like any other; false if its lane is full. `woken` follows the
+    // FreeRTOS FromISR convention: start with pdFALSE, end the ISR with
+    // portYIELD_FROM_ISR(woken).
+    bool set_text_from_isr(std::string_view text, BaseType_t* woken);
+    bool set_status_from_isr(std::string_view status, BaseType_t* woken);
+    bool set_number_from_isr(std::int32_t value, BaseType_t* woken, UiFormat format = "{}");
+
   private:
+    void submit(UiCommandType type, std::string_view payload);
+    bool send_from_isr(UiCommandType type, std::string_view payload, BaseType_t* woken);
+
     muc::ui::UiQueue& m_queue;
 };
 
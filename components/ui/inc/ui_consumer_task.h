@@ -4,7 +4,10 @@
 #include <cstdint>
 
 #include "lvgl.h"
+#include "ui_mailbox.h"
 #include "ui_queue.h"
+#include "ui_screens.h"
+#include "ui_widget_registry.h"
 
 namespace muc::ui
 {
@@ -12,7 +15,9 @@ namespace muc::ui
 struct LvglTaskConfig
 {
     std::uint32_t tick_period_ms;
-    std::uint32_t handler_period_ms;
+    // Shortest sleep between two handler passes. The actual sleep follows LVGL's next
+    // timer deadline, so a paused display (nothing invalidated) costs no wakeups.
+    std::uint32_t min_handler_period_ms;
     void* user_data;
 };
 
@@ -23,14 +28,42 @@ class UiConsumerTask
     static void lvgl_handler_task(void* arg);
     static void lvgl_tick_task(void* arg);
 
+    // Building blocks of the tasks above, usable without a FreeRTOS task (host runner)
+    static void create_widgets();
+    // Applies one command to its widget, skipping values the widget already shows. Runs
+    // on lvgl_handler in queue mode and on the producer task (under UiLock) in lock mode.
+    static void handle_message(const UiMessageView& msg);
+
+    // Latest state per widget, written by UiApi and by the queue drain
+    static UiMailbox& mailbox() noexcept;
+    // Applies the pending mailbox values (LVGL context: lvgl_handler, or UiLock held)
+    static void apply_mailbox();
+
+    // Widgets of the current screens by ID (LVGL context only)
+    static UiWidgetRegistry& widgets() noexcept;
+    static UiScreenManager& screens() noexcept;
+
+    // One pass of the handler loop: waits up to `wait` for a command, drains up to
+    // CONFIG_UI_MAX_MESSAGES_PER_PASS queued commands, applies the newest value of
+    // each widget, then runs LVGL timers once. Returns how long the next pass may block.
+    static TickType_t handler_pass(UiQueue& queue,
+                                   TickType_t wait,
+                                   std::uint32_t min_handler_period_ms);
+
   private:
-    static void set_view_mode(bool provisioning);
+    static void build_status_screen(lv_obj_t* screen);
+    static void build_provisioning_screen(lv_obj_t* screen);
+
+    // Returns true if anything on screen changed
+    static bool set_view_mode(bool provisioning);
+
+    // Drains up to CONFIG_UI_MAX_MESSAGES_PER_PASS queued commands (starting with
+    // `first`, if already received) and applies the newest value of each widget.
+    // Returns true if commands are left over.
+    static bool apply_commands(UiQueue& queue, UiMessageView* first);
 
-    // LVGL object pointers
-    static lv_obj_t* s_counter_label;
-    static lv_obj_t* s_status_label;
-    static lv_obj_t* s_qr_code;
-    static lv_obj_t* s_qr_container;
+    // lv_timer_handler() plus busy-time accounting from `start_us`
+    static TickType_t run_timers(std::int64_t start_us, std::uint32_t min_handler_period_ms);
 };
 
 } // namespace muc::ui
@@ -0,0 +1,50 @@
+#ifndef COMPONENTS_UI_INC_UI_LOCK_H
+#define COMPONENTS_UI_INC_UI_LOCK_H
+
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace muc::ui
+{
+
+// Scoped lv_lock() for tasks other than lvgl_handler (CONFIG_UI_UPDATE_MODE_LOCK).
+//
+//     {
+//         muc::ui::UiLock lock;
+//         lv_label_set_text(label, "42");
+//     }
+//
+// Keep the scope short: lv_timer_handler() takes the same lock for a whole render
+// pass. Wait and hold times are reported through UiMetrics. On release the
+// lvgl_handler task is woken so the change is rendered without waiting for its next
+// timer deadline. In queue mode LVGL has no OS layer and the lock is a no-op.
+class UiLock
+{
+  public:
+    // Task notification index of that wake-up. Index 0 is taken by LVGL's own
+    // LV_USE_FREERTOS_TASK_NOTIFY sync and by NotifyingRing::receive(), which must not
+    // consume or be woken by it.
+    static constexpr UBaseType_t kNotifyIndex = 1;
+
+    UiLock() noexcept;
+    ~UiLock();
+
+    UiLock(const UiLock&) = delete;
+    UiLock& operator=(const UiLock&) = delete;
+
+    // Task to notify after every release (the lvgl_handler task)
+    static void set_render_task(TaskHandle_t task) noexcept;
+
+    // ISR-safe wake-up of that task, for updates queued from interrupts (lock mode)
+    static void notify_render_task_from_isr(BaseType_t* higher_priority_task_woken) noexcept;
+
+  private:
+    std::int64_t m_request_us;
+    std::int64_t m_acquired_us;
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_LOCK_H
@@ -0,0 +1,110 @@
+#ifndef COMPONENTS_UI_INC_UI_MAILBOX_H
+#define COMPONENTS_UI_INC_UI_MAILBOX_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+#include "ui_queue.h"
+#include "ui_value.h"
+
+namespace muc::ui
+{
+
+// One slot per target widget: SetText and SetNumber both write the counter label, so
+// they share a slot and the one submitted last wins
+enum class UiMailboxSlot : std::uint8_t
+{
+    Counter, // SetText, SetNumber
+    Status,  // SetStatus
+    QrCode,  // ShowQrCode
+};
+
+constexpr std::size_t kMailboxSlots = 3;
+
+constexpr UiMailboxSlot slot_of(UiCommandType type) noexcept
+{
+    switch (type)
+    {
+    case UiCommandType::SetStatus:
+        return UiMailboxSlot::Status;
+    case UiCommandType::ShowQrCode:
+        return UiMailboxSlot::QrCode;
+    default:
+        return UiMailboxSlot::Counter;
+    }
+}
+
+// Payload capacity per slot; longer payloads are truncated. Text and status keep the
+// 127 bytes of the original fixed-size UiMessage; the QR slot fits an ESP provisioning
+// payload with a long service name.
+constexpr std::array<std::size_t, kMailboxSlots> kMailboxSlotBytes = {127, 127, 160};
+
+static_assert(sizeof(UiNumber) <=
+                  kMailboxSlotBytes[static_cast<std::size_t>(UiMailboxSlot::Counter)],
+              "SetNumber shares the counter slot");
+
+static_assert(*std::max_element(kMailboxSlotBytes.begin(), kMailboxSlotBytes.end()) <=
+                  kUiMaxPayloadBytes,
+              "a slot payload must fit a UiQueue record");
+
+// All slot payloads plus their NUL terminators
+constexpr std::size_t kMailboxPoolBytes = []
+{
+    std::size_t total = 0;
+    for (std::size_t bytes : kMailboxSlotBytes)
+    {
+        total += bytes + 1;
+    }
+    return total;
+}();
+
+// Last-writer-wins state for the UI widgets.
+//
+// Producers overwrite the slot of a widget; the consumer takes every slot that
+// changed since its last pass, urgent lane first and otherwise in submission order,
+// and renders only those values. "Last" is by submission time, not by arrival: ISR
+// commands reach the mailbox only when lvgl_handler drains UiQueue, after direct posts
+// that may be newer, so a post older than the slot's current value is dropped.
+// Obsolete values are never rendered and the newest one is never lost.
+class UiMailbox
+{
+  public:
+    UiMailbox() noexcept;
+
+    UiMailbox(const UiMailbox&) = delete;
+    UiMailbox& operator=(const UiMailbox&) = delete;
+
+    // `submitted_us` must come from ui_submit_time_us() (ui_api.h). Returns true if no slot was
+    // pending before, i.e. the consumer needs a wake-up.
+    bool post(UiCommandType type, std::string_view payload, std::int64_t submitted_us) noexcept;
+
+    // Consumer only: views of the pending values (urgent lane first, then oldest
+    // submission first), valid until the next take(); returns how many
+    std::size_t take(std::array<UiMessageView, kMailboxSlots>& out) noexcept;
+
+  private:
+    struct Slot
+    {
+        std::size_t offset; // into the pools
+        std::size_t length;
+        UiCommandType type;        // of the value in the slot
+        std::int64_t submitted_us; // of the value in the slot, pending or not
+        bool pending;
+    };
+
+    std::mutex m_mutex;
+    std::array<Slot, kMailboxSlots> m_slots{};
+    std::array<char, kMailboxPoolBytes> m_pool{};
+    std::size_t m_pending = 0;
+
+    // Consumer copy, so LVGL never runs with m_mutex held
+    std::array<char, kMailboxPoolBytes> m_taken{};
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_MAILBOX_H
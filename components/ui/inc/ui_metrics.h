@@ -0,0 +1,92 @@
+#ifndef COMPONENTS_UI_INC_UI_METRICS_H
+#define COMPONENTS_UI_INC_UI_METRICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "lvgl.h"
+#include "ui_queue.h"
+#include "ui_screens.h"
+
+namespace muc::ui
+{
+
+struct UiLaneStats
+{
+    std::uint32_t updates;
+    std::uint32_t latency_avg_us;
+    std::uint32_t latency_max_us;
+    std::uint32_t superseded;
+    std::uint32_t refused; // UiQueue had no room left for the lane
+};
+
+struct UiUpdateStats
+{
+    bool lock_mode; // CONFIG_UI_UPDATE_MODE_LOCK
+
+    // Submit (UiApi call) -> first rendered frame that contains the update
+    std::uint32_t updates;
+    std::uint32_t latency_avg_us;
+    std::uint32_t latency_max_us;
+    std::uint32_t superseded; // overwritten in the mailbox before being rendered
+    std::array<UiLaneStats, kUiLanes> lanes; // the same, split by UiLane
+    std::uint32_t unchanged; // value already shown, applied without a render
+
+    // LVGL heap taken by each prebuilt screen, and how often the active one changed
+    std::array<std::uint32_t, kUiScreens> screen_heap_bytes;
+    std::uint32_t screen_switches;
+
+    // CPU spent on UI updates: producer side (UiApi calls, including the queue copy or
+    // the lock + widget update) and consumer side (handler passes, excluding blocking)
+    std::uint64_t producer_busy_us;
+    std::uint64_t handler_busy_us;
+    std::uint32_t handler_passes;
+
+    // Queue mode: handler passes that received commands, and how many they drained
+    std::uint32_t drain_passes;
+    std::uint32_t messages_per_pass_avg;
+    std::uint32_t messages_per_pass_max;
+    std::uint32_t queue_high_water; // most commands waiting in UiQueue at once
+
+    // Producer lock acquisitions (lock mode and UiLock users only)
+    std::uint32_t lock_acquisitions;
+    std::uint32_t lock_contended; // had to wait for the LVGL task or another producer
+    std::uint32_t lock_wait_max_us;
+    std::uint32_t lock_hold_avg_us;
+    std::uint32_t lock_hold_max_us;
+};
+
+// Update-path instrumentation shared by the queue and lock modes, so that both can be
+// compared on the same workload. Safe to call from any task; only the *_from_isr
+// members may be called from interrupts.
+class UiMetrics
+{
+  public:
+    // Closes pending latency measurements when `disp` finishes rendering a frame
+    static void attach(lv_display_t* disp) noexcept;
+
+    // An update submitted at `submitted_us` has been applied to the widgets
+    static void applied(UiLane lane, std::int64_t submitted_us) noexcept;
+
+    static void record_superseded(UiLane lane) noexcept;
+    static void record_refused(UiLane lane) noexcept;
+    // Same counter, without the mutex; merged into stats()
+    static void record_refused_from_isr(UiLane lane) noexcept;
+    static void record_unchanged() noexcept;
+    static void record_screen_heap(UiScreenId id, std::size_t bytes) noexcept;
+    static void record_screen_switch() noexcept;
+    static void record_producer(std::uint32_t busy_us) noexcept;
+    static void record_handler_pass(std::uint32_t busy_us) noexcept;
+    static void record_drain(std::uint32_t messages, std::size_t queue_high_water) noexcept;
+    static void record_lock(std::uint32_t wait_us, std::uint32_t hold_us) noexcept;
+
+    static UiUpdateStats stats() noexcept;
+
+  private:
+    static void render_ready_cb(lv_event_t* e);
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_METRICS_H
@@ -0,0 +1,87 @@
+#ifndef COMPONENTS_UI_INC_UI_QR_VIEW_H
+#define COMPONENTS_UI_INC_UI_QR_VIEW_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "lvgl.h"
+
+namespace muc::ui
+{
+
+// Side of the QR view in pixels
+constexpr std::int32_t kQrViewPixels = 58;
+
+// Largest QR version encoded (57x57 modules, 213 bytes at ECC medium); covers the
+// mailbox's ShowQrCode slot
+constexpr int kQrMaxVersion = 10;
+
+// Longest payload kQrMaxVersion holds in byte mode at ECC medium
+constexpr std::size_t kQrMaxPayloadBytes = 213;
+
+// Encoded symbol in qrcodegen's layout (side length, then one bit per module)
+constexpr std::size_t kQrSymbolBytes =
+    ((kQrMaxVersion * 4 + 17) * (kQrMaxVersion * 4 + 17) + 7) / 8 + 1;
+
+// QR code rendered straight into a 1-bit image.
+//
+// Replaces lv_qrcode, which allocates a canvas plus two encoder buffers from the LVGL
+// heap and re-encodes on every update. Here the encoder works in static buffers, the
+// module matrix of recent payloads is cached with the payload itself (and, with
+// CONFIG_UI_QR_CACHE_NVS, persisted so a re-provisioned device shows its code without
+// encoding), and every module is written as an integer-scaled block of I1 pixels that
+// LVGL blits like any other image. LVGL context only.
+class UiQrView
+{
+  public:
+    UiQrView() noexcept = default;
+
+    UiQrView(const UiQrView&) = delete;
+    UiQrView& operator=(const UiQrView&) = delete;
+
+    // Creates the kQrViewPixels square lv_image on `parent`; its user data points back
+    // to this view (see UiWidgetKind::QrCode)
+    lv_obj_t* create(lv_obj_t* parent) noexcept;
+
+    // Shows the code of `payload`; false (view left blank) if it needs more than
+    // kQrMaxVersion
+    bool set_payload(std::string_view payload) noexcept;
+
+    // Whether the view currently shows the code of exactly `payload`
+    bool shows(std::string_view payload) const noexcept;
+
+  private:
+    static constexpr std::size_t kCacheEntries = 2;
+    static constexpr std::size_t kStrideBytes = (kQrViewPixels + 7) / 8;
+    static constexpr std::size_t kPaletteBytes = 2 * sizeof(lv_color32_t);
+
+    struct CacheEntry
+    {
+        std::uint32_t hash; // payload_hash(), checked before the payload bytes
+        std::uint16_t length;
+        bool valid;
+        std::array<char, kQrMaxPayloadBytes> payload;
+        std::array<std::uint8_t, kQrSymbolBytes> symbol;
+
+        bool holds(std::string_view value, std::uint32_t value_hash) const noexcept;
+    };
+
+    const CacheEntry* lookup(std::string_view payload, std::uint32_t hash) const noexcept;
+    const CacheEntry* encode(std::string_view payload, std::uint32_t hash) noexcept;
+    void render(const CacheEntry* entry) noexcept;
+
+    lv_obj_t* m_image = nullptr;
+    lv_image_dsc_t m_dsc{};
+    // I1 image: 2-entry palette, then rows of kStrideBytes (MSB = leftmost pixel)
+    std::array<std::uint8_t, kPaletteBytes + kStrideBytes * kQrViewPixels> m_pixels{};
+
+    std::array<CacheEntry, kCacheEntries> m_cache{};
+    std::size_t m_next_entry = 0;
+    const CacheEntry* m_shown = nullptr; // nullptr while blank
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_QR_VIEW_H
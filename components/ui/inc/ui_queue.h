@@ -3,53 +3,195 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <string_view>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <sdkconfig.h>
+
+#if CONFIG_UI_QUEUE_BACKEND_RING
+#include "ring_buffer.h"
+#elif !CONFIG_UI_QUEUE_BACKEND_FREERTOS
+#include <freertos/ringbuf.h>
+#endif
 
 namespace muc::ui
 {
 
-enum class UiCommandType
+enum class UiCommandType : std::uint8_t
 {
     SetText,
     SetStatus,
-    ShowQrCode
+    ShowQrCode,
+    SetNumber, // UiNumber bytes, formatted by the consumer
+    // No payload: state commands are waiting in the UiMailbox
+    MailboxPosted
+};
+
+// Priority lanes. Urgent commands (connection status, provisioning QR) are applied
+// before bulk ones (periodic text) and always find room in UiQueue; bulk commands are
+// refused once the queue is three quarters full and coalesce in the mailbox instead.
+enum class UiLane : std::uint8_t
+{
+    Urgent,
+    Bulk
+};
+
+constexpr std::size_t kUiLanes = 2;
+
+constexpr UiLane lane_of(UiCommandType type) noexcept
+{
+    return type == UiCommandType::SetText || type == UiCommandType::SetNumber ? UiLane::Bulk
+                                                                              : UiLane::Urgent;
+}
+
+// Longest payload of a single message
+constexpr std::size_t kUiMaxPayloadBytes = 255;
+
+// Longest payload accepted from an ISR. Bounds the copy; the ISR stack holds a record of
+// at most this payload in the ring-buffer backend, but a whole UiMessage (128-byte text
+// plus header) in the fixed-size ones, whose items are UiMessages.
+constexpr std::size_t kUiIsrMaxPayloadBytes = 32;
+
+// A received message. `payload` stays valid until UiQueue::release() and is always
+// followed by a NUL, so it can be handed to LVGL as a C string.
+struct UiMessageView
+{
+    UiCommandType type;
+    std::int64_t submitted_us; // esp_timer time of the UiApi call (latency metrics)
+    std::string_view payload;
 };
 
+// Fixed-size storage of the FreeRTOS-queue and MPSC-ring backends. `length` is
+// authoritative: binary payloads (UiNumber) contain zero bytes.
 class UiMessage
 {
   public:
     void set_payload(std::string_view sv);
 
     UiCommandType type;
+    std::uint8_t length; // of the payload in `text`, which is NUL-terminated after it
+    std::int64_t submitted_us;
     std::array<char, 128> text;
 };
 
-class UiQueue
+static_assert(sizeof(UiMessage::text) - 1 <= UINT8_MAX, "UiMessage::length is 8 bits");
+
+#if CONFIG_UI_QUEUE_BACKEND_RING
+// Compile-time capacity of the ring backend; UiQueue's queue_size must fit
+constexpr std::size_t kUiQueueRingCapacity = 32;
+#endif
+
+// Producer-side handle of a message being written in place (UiQueue::reserve)
+class UiReservation
 {
   public:
-    explicit UiQueue(size_t queue_size)
+    char* payload() noexcept
     {
-        m_handle = xQueueCreate(queue_size, sizeof(UiMessage));
+        return m_payload;
     }
 
-    bool send(const UiMessage& msg)
+    std::size_t size() const noexcept
     {
-        return xQueueSend(m_handle, &msg, 0) == pdTRUE;
+        return m_size;
     }
 
-    bool receive(UiMessage& msg)
+  private:
+    friend class UiQueue;
+
+    char* m_payload = nullptr;
+    std::size_t m_size = 0;
+#if CONFIG_UI_QUEUE_BACKEND_RING || CONFIG_UI_QUEUE_BACKEND_FREERTOS
+    UiMessage m_staging;
+#else
+    void* m_item = nullptr;
+#endif
+};
+
+// Channel from UiApi to the lvgl_handler task.
+//
+// The default backend stores variable-length records (header + payload + NUL) in an
+// ESP-IDF no-split ring buffer: producers reserve and fill a record in place, the
+// consumer reads it in place and hands it back. The fixed-size backends (Kconfig
+// UI_QUEUE_BACKEND) offer the same interface on top of UiMessage copies.
+class UiQueue
+{
+  public:
+    // Fixed-size backends: number of messages. Byte stream: CONFIG_UI_QUEUE_STREAM_BYTES.
+    explicit UiQueue(size_t queue_size);
+
+    UiQueue(const UiQueue&) = delete;
+    UiQueue& operator=(const UiQueue&) = delete;
+
+    // Copies `payload` (truncated to kUiMaxPayloadBytes); never blocks
+    bool send(UiCommandType type,
+              std::string_view payload,
+              std::int64_t submitted_us,
+              UiLane lane);
+
+    // Zero-copy send: reserve `length` payload bytes, fill reservation.payload() with
+    // reservation.size() bytes, commit. Fails without blocking when the queue is full,
+    // or for the bulk lane when only the urgent share is left. The fixed-size backends
+    // only find out at commit(), which then returns false and drops the message.
+    bool reserve(UiCommandType type,
+                 std::size_t length,
+                 std::int64_t submitted_us,
+                 UiLane lane,
+                 UiReservation& reservation);
+    bool commit(UiReservation& reservation);
+
+    // ISR-safe send: copies `payload` (truncated to kUiIsrMaxPayloadBytes) in bounded
+    // time, without locks or blocking, staging it on the ISR stack (see
+    // kUiIsrMaxPayloadBytes). Sets *higher_priority_task_woken if the consumer
+    // was unblocked; the ISR then ends with portYIELD_FROM_ISR().
+    bool send_from_isr(UiCommandType type,
+                       std::string_view payload,
+                       std::int64_t submitted_us,
+                       UiLane lane,
+                       BaseType_t* higher_priority_task_woken);
+
+    // Single consumer; every successful receive() must be followed by release()
+    bool receive(UiMessageView& view, TickType_t timeout = portMAX_DELAY);
+    void release(const UiMessageView& view);
+
+    // Most messages ever waiting at once since construction (any task)
+    std::size_t high_water() const noexcept
     {
-        return xQueueReceive(m_handle, &msg, portMAX_DELAY) == pdTRUE;
+        return m_high_water.load(std::memory_order_relaxed);
     }
 
   private:
+    // Producers: one more message in flight, raising the high-water mark if needed
+    void count_sent() noexcept;
+
+    std::atomic<std::size_t> m_depth{0};
+    std::atomic<std::size_t> m_high_water{0};
+#if CONFIG_UI_QUEUE_BACKEND_RING || CONFIG_UI_QUEUE_BACKEND_FREERTOS
+    std::size_t m_bulk_limit; // depth up to which bulk messages are admitted
+#endif
+
+#if CONFIG_UI_QUEUE_BACKEND_RING
+    NotifyingRing<MpscRing<UiMessage, kUiQueueRingCapacity>> m_ring;
+    UiMessage m_rx;
+#elif CONFIG_UI_QUEUE_BACKEND_FREERTOS
     QueueHandle_t m_handle;
+    UiMessage m_rx;
+#else
+    // Room for a record of `record_bytes` in the lane, from the byte accounting below
+    bool admits(UiLane lane, std::size_t record_bytes) const noexcept;
+
+    RingbufHandle_t m_handle;
+    void* m_rx_item = nullptr;
+    std::size_t m_rx_bytes = 0;
+    // Ring buffer bytes taken by records, counted like ESP-IDF does; readable from ISRs
+    std::atomic<std::size_t> m_used_bytes{0};
+#endif
 };
 
 } // namespace muc::ui
 
-#endif // COMPONENTS_UI_INC_UI_QUEUE_H
\ No newline at end of file
+#endif // COMPONENTS_UI_INC_UI_QUEUE_H
@@ -0,0 +1,53 @@
+#ifndef COMPONENTS_UI_INC_UI_SCREENS_H
+#define COMPONENTS_UI_INC_UI_SCREENS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "lvgl.h"
+
+namespace muc::ui
+{
+
+enum class UiScreenId : std::uint8_t
+{
+    Provisioning, // QR code
+    Status,       // counter and status labels
+};
+
+constexpr std::size_t kUiScreens = 2;
+
+// Owns the prebuilt LVGL screens.
+//
+// Every screen is built exactly once and then only loaded, so switching between
+// provisioning and normal operation never allocates or frees LVGL objects (the QR
+// canvas in particular) and cannot fragment the LVGL heap over re-provisioning cycles.
+// LVGL context only.
+class UiScreenManager
+{
+  public:
+    using BuildFn = void (*)(lv_obj_t* screen);
+
+    UiScreenManager() noexcept = default;
+
+    UiScreenManager(const UiScreenManager&) = delete;
+    UiScreenManager& operator=(const UiScreenManager&) = delete;
+
+    // Runs `build` on `root` (nullptr: a new LVGL screen) and reports the LVGL heap it
+    // used to UiMetrics. Each ID is built once; later calls are ignored.
+    void build(UiScreenId id, lv_obj_t* root, BuildFn build) noexcept;
+
+    // Loads a prebuilt screen; returns true if it was not already active
+    bool show(UiScreenId id) noexcept;
+
+    lv_obj_t* screen(UiScreenId id) const noexcept;
+
+  private:
+    std::array<lv_obj_t*, kUiScreens> m_screens{};
+    lv_obj_t* m_active = nullptr;
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_SCREENS_H
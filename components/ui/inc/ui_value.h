@@ -0,0 +1,70 @@
+#ifndef COMPONENTS_UI_INC_UI_VALUE_H
+#define COMPONENTS_UI_INC_UI_VALUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace muc::ui
+{
+
+// Text around a typed value: exactly one "{}" marks where the value goes ("{} C",
+// "RSSI {} dBm"). Checked at compile time, and only string literals are accepted, so
+// the pointer can travel through UiQueue and be used later by lvgl_handler.
+class UiFormat
+{
+  public:
+    template <std::size_t N>
+    consteval UiFormat(const char (&text)[N])
+    : m_text(text)
+    {
+        if (placeholders(text, N - 1) != 1)
+        {
+            throw "UiFormat needs exactly one {} placeholder";
+        }
+    }
+
+    const char* text() const noexcept
+    {
+        return m_text;
+    }
+
+  private:
+    static consteval int placeholders(const char* text, std::size_t length)
+    {
+        int count = 0;
+        for (std::size_t i = 0; i + 1 < length; ++i)
+        {
+            if (text[i] == '{' && text[i + 1] == '}')
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    const char* m_text;
+};
+
+// Raw typed value as carried in a SetNumber payload: `raw` / 10^decimals, formatted
+// by the consumer. No implicit padding, so equal values have equal bytes.
+struct UiNumber
+{
+    const char* format; // UiFormat::text()
+    std::int32_t raw;
+    std::uint8_t decimals;
+    std::uint8_t reserved[3];
+};
+static_assert(std::has_unique_object_representations_v<UiNumber>, "compared with memcmp()");
+
+// Longest formatted value the consumer produces (format text included)
+constexpr std::size_t kUiNumberTextBytes = 48;
+
+// Writes the formatted, NUL-terminated text of `number` into `out`; returns its length
+// (truncated to out.size() - 1)
+std::size_t format_number(const UiNumber& number, std::span<char> out) noexcept;
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_VALUE_H
@@ -0,0 +1,97 @@
+#ifndef COMPONENTS_UI_INC_UI_WIDGET_REGISTRY_H
+#define COMPONENTS_UI_INC_UI_WIDGET_REGISTRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "lvgl.h"
+#include "ui_queue.h"
+#include "ui_value.h"
+
+namespace muc::ui
+{
+
+// Compact IDs of the widgets the UI updates after creation
+enum class UiWidgetId : std::uint8_t
+{
+    CounterLabel,
+    StatusLabel,
+    ProvisionQr,
+    ProvisionQrFrame,
+};
+
+constexpr std::size_t kUiMaxWidgets = 16;
+
+// What set_value() does with a widget
+enum class UiWidgetKind : std::uint8_t
+{
+    Object, // layout only, no value
+    Label,
+    QrCode, // lv_image created by UiQrView::create()
+};
+
+// FNV-1a of an update value; a quick pre-check before payloads are compared
+std::uint32_t payload_hash(std::string_view value) noexcept;
+
+// Widget addressed by a state command
+constexpr UiWidgetId widget_of(UiCommandType type) noexcept
+{
+    switch (type)
+    {
+    case UiCommandType::SetStatus:
+        return UiWidgetId::StatusLabel;
+    case UiCommandType::ShowQrCode:
+        return UiWidgetId::ProvisionQr;
+    case UiCommandType::SetNumber:
+        return UiWidgetId::CounterLabel;
+    default:
+        return UiWidgetId::CounterLabel;
+    }
+}
+
+// ID -> LVGL object table owned by the lvgl_handler side.
+//
+// Screens register the widgets they create; updates are addressed by ID and only touch
+// LVGL (and thus invalidate and re-render) when the value actually differs from what the
+// widget shows. Entries clear themselves when LVGL deletes the object. Like every LVGL
+// call, all methods must run in the LVGL context (lvgl_handler or under UiLock).
+class UiWidgetRegistry
+{
+  public:
+    UiWidgetRegistry() noexcept = default;
+
+    UiWidgetRegistry(const UiWidgetRegistry&) = delete;
+    UiWidgetRegistry& operator=(const UiWidgetRegistry&) = delete;
+
+    void add(UiWidgetId id, lv_obj_t* obj, UiWidgetKind kind) noexcept;
+    lv_obj_t* get(UiWidgetId id) const noexcept;
+
+    // `value` must be followed by a NUL (see UiMessageView). Returns true if the widget
+    // changed, false if it already showed `value` or `id` is not registered.
+    bool set_value(UiWidgetId id, std::string_view value) noexcept;
+
+    // Label only: formats `number` unless the label already shows this very number and
+    // format, so an unchanged value costs neither formatting nor a render
+    bool set_number(UiWidgetId id, const UiNumber& number) noexcept;
+
+  private:
+    struct Entry
+    {
+        lv_obj_t* obj;
+        UiWidgetKind kind;
+        // Numbers are compared before being formatted, so labels remember the last one
+        bool has_number;
+        UiNumber number;
+    };
+
+    static bool set_label_text(lv_obj_t* label, std::string_view text) noexcept;
+    static void delete_cb(lv_event_t* e);
+
+    std::array<Entry, kUiMaxWidgets> m_entries{};
+};
+
+} // namespace muc::ui
+
+#endif // COMPONENTS_UI_INC_UI_WIDGET_REGISTRY_H
@@ -1,36 +1,137 @@
 #include "ui_api.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+#include "ui_consumer_task.h"
+#include "ui_lock.h"
+#include "ui_metrics.h"
 #include "ui_queue.h"
 
 namespace muc::ui
 {
 
+std::int64_t ui_submit_time_us() noexcept
+{
+    // 64-bit CAS is a short critical section on the C3, so this is ISR-safe too
+    static std::atomic<std::int64_t> s_last{0};
+
+    const std::int64_t now = esp_timer_get_time();
+    std::int64_t last = s_last.load(std::memory_order_relaxed);
+    std::int64_t next = 0;
+    do
+    {
+        next = std::max(now, last + 1);
+    } while (!s_last.compare_exchange_weak(last, next, std::memory_order_relaxed));
+    return next;
+}
+
 UiApi::UiApi(UiQueue& queue)
 : m_queue(queue)
 {
 }
 
+// -----------------------------------------------------------------------------
+// Every command goes through submit(): posted to the widget mailboxes for
+// lvgl_handler in queue mode, applied from the calling task under the LVGL lock in
+// lock mode
+// -----------------------------------------------------------------------------
+void UiApi::submit(UiCommandType type, std::string_view payload)
+{
+    const std::int64_t start_us = ui_submit_time_us();
+
+#if CONFIG_UI_UPDATE_MODE_LOCK
+    // Through the mailbox as well, so an older ISR command drained later by
+    // lvgl_handler cannot overwrite this one (the mailbox also truncates)
+    {
+        UiLock lock;
+        (void)UiConsumerTask::mailbox().post(type, payload, start_us);
+        UiConsumerTask::apply_mailbox();
+    }
+#else
+    // Overwrite the widget's mailbox slot; only the first pending value queues a wake-up,
+    // in the command's lane. If that wake-up is refused the queue is (nearly) full, so
+    // the consumer is running anyway and drains the mailbox on its next pass.
+    const UiLane lane = lane_of(type);
+    if (UiConsumerTask::mailbox().post(type, payload, start_us) &&
+        !m_queue.send(UiCommandType::MailboxPosted, {}, start_us, lane))
+    {
+        UiMetrics::record_refused(lane);
+    }
+#endif
+
+    UiMetrics::record_producer(static_cast<std::uint32_t>(esp_timer_get_time() - start_us));
+}
+
 void UiApi::set_text(std::string_view text)
 {
-    UiMessage msg;
-    msg.type = UiCommandType::SetText;
-    msg.set_payload(text); // Helper in UiMessage to copy string safely
-    m_queue.send(msg);
+    submit(UiCommandType::SetText, text);
+}
+
+void UiApi::set_number(std::int32_t value, UiFormat format)
+{
+    set_fixed(value, 0, format);
+}
+
+void UiApi::set_fixed(std::int32_t raw, std::uint8_t decimals, UiFormat format)
+{
+    const UiNumber number{
+        .format = format.text(), .raw = raw, .decimals = decimals, .reserved = {}};
+    submit(UiCommandType::SetNumber,
+           std::string_view(reinterpret_cast<const char*>(&number), sizeof(number)));
 }
 
 void UiApi::set_status(std::string_view status)
 {
-    UiMessage msg;
-    msg.type = UiCommandType::SetStatus;
-    msg.set_payload(status);
-    m_queue.send(msg);
+    submit(UiCommandType::SetStatus, status);
 }
 
 void UiApi::show_provision_qr(std::string_view payload)
 {
-    UiMessage msg;
-    msg.type = UiCommandType::ShowQrCode;
-    msg.set_payload(payload);
-    m_queue.send(msg);
+    submit(UiCommandType::ShowQrCode, payload);
+}
+
+// -----------------------------------------------------------------------------
+// Interrupt context: straight into UiQueue, applied by lvgl_handler in both modes
+// -----------------------------------------------------------------------------
+bool UiApi::send_from_isr(UiCommandType type, std::string_view payload, BaseType_t* woken)
+{
+    const UiLane lane = lane_of(type);
+    const bool sent = m_queue.send_from_isr(type, payload, ui_submit_time_us(), lane, woken);
+    if (!sent)
+    {
+        UiMetrics::record_refused_from_isr(lane);
+    }
+#if CONFIG_UI_UPDATE_MODE_LOCK
+    // lvgl_handler waits for notifications, not on the queue, in lock mode
+    if (sent)
+    {
+        UiLock::notify_render_task_from_isr(woken);
+    }
+#endif
+    return sent;
+}
+
+bool UiApi::set_text_from_isr(std::string_view text, BaseType_t* woken)
+{
+    return send_from_isr(UiCommandType::SetText, text, woken);
+}
+
+bool UiApi::set_status_from_isr(std::string_view status, BaseType_t* woken)
+{
+    return send_from_isr(UiCommandType::SetStatus, status, woken);
+}
+
+bool UiApi::set_number_from_isr(std::int32_t value, BaseType_t* woken, UiFormat format)
+{
+    const UiNumber number{.format = format.text(), .raw = value, .decimals = 0, .reserved = {}};
+    return send_from_isr(UiCommandType::SetNumber,
+                         std::string_view(reinterpret_cast<const char*>(&number), sizeof(number)),
+                         woken);
 }
 
-} // namespace muc::ui
\ No newline at end of file
+} // namespace muc::ui
@@ -1,149 +1,343 @@
 #include "ui_consumer_task.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 
 #include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <sdkconfig.h>
 
 #include "lvgl.h"
+#include "ui_lock.h"
+#include "ui_metrics.h"
+#include "ui_qr_view.h"
 #include "ui_queue.h"
+#include "ui_screens.h"
+#include "ui_widget_registry.h"
+
+#if CONFIG_UI_STATUS_FONT_FREETYPE
+#include "FontRenderer.h"
+#include "LvglFont.h"
+
+// TTF embedded by the fonts component
+extern "C"
+{
+extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_start[] asm(
+    "_binary_oled_subset_ascii_umlaut_ttf_start");
+extern const std::uint8_t _binary_oled_subset_ascii_umlaut_ttf_end[] asm(
+    "_binary_oled_subset_ascii_umlaut_ttf_end");
+}
+#endif
 
 namespace muc::ui
 {
 
-lv_obj_t* UiConsumerTask::s_counter_label = nullptr;
-lv_obj_t* UiConsumerTask::s_status_label = nullptr;
-lv_obj_t* UiConsumerTask::s_qr_code = nullptr;
-lv_obj_t* UiConsumerTask::s_qr_container = nullptr;
+namespace
+{
+// Returns true if the flag actually changed (and LVGL invalidated the object)
+bool set_hidden(lv_obj_t* obj, bool hidden)
+{
+    if (!obj || lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hidden)
+    {
+        return false;
+    }
+
+    if (hidden)
+    {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    else
+    {
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    return true;
+}
+
+#if CONFIG_UI_STATUS_FONT_FREETYPE
+const char* TAG = "UiConsumer";
+#endif
+
+// Font of the status screen labels; built once, on the LVGL context
+const lv_font_t* status_font()
+{
+#if CONFIG_UI_STATUS_FONT_FREETYPE
+    // Static: the glyph cache is too large for a task stack
+    static muc::fonts::FontRenderer s_renderer;
+    static muc::fonts::LvglFont s_font;
+
+    const std::size_t ttf_size =
+        reinterpret_cast<std::uintptr_t>(_binary_oled_subset_ascii_umlaut_ttf_end) -
+        reinterpret_cast<std::uintptr_t>(_binary_oled_subset_ascii_umlaut_ttf_start);
+    if (s_renderer.init(_binary_oled_subset_ascii_umlaut_ttf_start, ttf_size, 12) &&
+        s_font.init(s_renderer, 12, &lv_font_montserrat_12))
+    {
+        return s_font.font();
+    }
+    ESP_LOGE(TAG, "TTF font init failed, using lv_font_montserrat_12");
+#endif
+    return &lv_font_montserrat_12;
+}
+} // namespace
+
+UiMailbox& UiConsumerTask::mailbox() noexcept
+{
+    static UiMailbox s_mailbox;
+    return s_mailbox;
+}
+
+UiWidgetRegistry& UiConsumerTask::widgets() noexcept
+{
+    static UiWidgetRegistry s_widgets;
+    return s_widgets;
+}
+
+UiScreenManager& UiConsumerTask::screens() noexcept
+{
+    static UiScreenManager s_screens;
+    return s_screens;
+}
 
 void UiConsumerTask::ui_init_task(void* arg)
+{
+    {
+        UiLock lock;
+        create_widgets();
+    }
+    vTaskDelete(nullptr);
+}
+
+void UiConsumerTask::create_widgets()
+{
+    // Every screen is built once here; mode changes only load them
+    screens().build(UiScreenId::Status, lv_scr_act(), build_status_screen);
+    screens().build(UiScreenId::Provisioning, nullptr, build_provisioning_screen);
+    screens().show(UiScreenId::Provisioning);
+
+    UiMetrics::attach(lv_display_get_default());
+}
+
+void UiConsumerTask::build_status_screen(lv_obj_t* screen)
 {
     static lv_style_t style_main;
     lv_style_init(&style_main);
-    lv_style_set_text_font(&style_main, &lv_font_montserrat_12);
+    lv_style_set_text_font(&style_main, status_font());
 
     // Counter label (top)
-    s_counter_label = lv_label_create(lv_scr_act());
-    lv_obj_add_style(s_counter_label, &style_main, 0);
-    lv_obj_align(s_counter_label, LV_ALIGN_TOP_MID, 0, 0);
-    lv_label_set_text(s_counter_label, "0");
+    lv_obj_t* counter_label = lv_label_create(screen);
+    lv_obj_add_style(counter_label, &style_main, 0);
+    lv_obj_align(counter_label, LV_ALIGN_TOP_MID, 0, 0);
+    lv_label_set_text(counter_label, "0");
 
     // Status label (bottom)
-    s_status_label = lv_label_create(lv_scr_act());
-    lv_obj_add_style(s_status_label, &style_main, 0);
-    lv_obj_set_width(s_status_label, 72);
-    lv_obj_set_style_text_align(s_status_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_label_set_long_mode(s_status_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_align(s_status_label, LV_ALIGN_BOTTOM_MID, 0, 0);
-    lv_label_set_text(s_status_label, "START");
-
-    // Hide labels initially (provisioning mode)
-    lv_obj_add_flag(s_counter_label, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_add_flag(s_status_label, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_t* status_label = lv_label_create(screen);
+    lv_obj_add_style(status_label, &style_main, 0);
+    lv_obj_set_width(status_label, 72);
+    lv_obj_set_style_text_align(status_label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_long_mode(status_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_obj_align(status_label, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_label_set_text(status_label, "START");
 
-    vTaskDelete(nullptr);
+    widgets().add(UiWidgetId::CounterLabel, counter_label, UiWidgetKind::Label);
+    widgets().add(UiWidgetId::StatusLabel, status_label, UiWidgetKind::Label);
 }
 
-void UiConsumerTask::set_view_mode(bool provisioning)
+void UiConsumerTask::build_provisioning_screen(lv_obj_t* screen)
+{
+    // Create container; hidden (blank screen) until the first QR payload arrives
+    lv_obj_t* container = lv_obj_create(screen);
+    lv_obj_set_size(container, 62, 62);
+    lv_obj_set_style_bg_color(container, lv_color_white(), 0);
+    lv_obj_set_style_border_width(container, 0, 0);
+    lv_obj_set_style_radius(container, 0, 0);
+    lv_obj_set_style_pad_all(container, 2, 0);
+    lv_obj_center(container);
+    lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
+
+    // QR view inside container; its 1-bit pixels are static, nothing is allocated later
+    static UiQrView s_qr_view;
+    lv_obj_t* qr_code = s_qr_view.create(container);
+    lv_obj_center(qr_code);
+
+    widgets().add(UiWidgetId::ProvisionQrFrame, container, UiWidgetKind::Object);
+    widgets().add(UiWidgetId::ProvisionQr, qr_code, UiWidgetKind::QrCode);
+}
+
+bool UiConsumerTask::set_view_mode(bool provisioning)
 {
     if (provisioning)
     {
-        // Hide labels
-        if (s_counter_label)
-        {
-            lv_obj_add_flag(s_counter_label, LV_OBJ_FLAG_HIDDEN);
-        }
-        if (s_status_label)
-        {
-            lv_obj_add_flag(s_status_label, LV_OBJ_FLAG_HIDDEN);
-        }
+        const bool revealed = set_hidden(widgets().get(UiWidgetId::ProvisionQrFrame), false);
+        return screens().show(UiScreenId::Provisioning) || revealed;
+    }
+    return screens().show(UiScreenId::Status);
+}
+
+void UiConsumerTask::handle_message(const UiMessageView& msg)
+{
+    UiWidgetRegistry& registry = widgets();
+    bool changed = false;
 
-        // Show QR container
-        if (s_qr_container)
+    switch (msg.type)
+    {
+    case UiCommandType::SetText:
+        changed = registry.set_value(UiWidgetId::CounterLabel, msg.payload);
+        break;
+
+    case UiCommandType::SetNumber:
+        if (msg.payload.size() == sizeof(UiNumber))
         {
-            lv_obj_clear_flag(s_qr_container, LV_OBJ_FLAG_HIDDEN);
+            UiNumber number;
+            std::memcpy(&number, msg.payload.data(), sizeof(number));
+            changed = registry.set_number(UiWidgetId::CounterLabel, number);
         }
+        break;
+
+    case UiCommandType::SetStatus:
+        changed = set_view_mode(false);
+        changed |= registry.set_value(UiWidgetId::StatusLabel, msg.payload);
+        break;
+
+    case UiCommandType::ShowQrCode:
+        changed = registry.set_value(UiWidgetId::ProvisionQr, msg.payload);
+        changed |= set_view_mode(true);
+        break;
+
+    default:
+        break;
+    }
+
+    // An identical value leaves the screen untouched and causes no render
+    if (changed)
+    {
+        UiMetrics::applied(lane_of(msg.type), msg.submitted_us);
     }
     else
     {
-        // Show labels
-        if (s_counter_label)
-        {
-            lv_obj_clear_flag(s_counter_label, LV_OBJ_FLAG_HIDDEN);
-        }
-        if (s_status_label)
+        UiMetrics::record_unchanged();
+    }
+}
+
+TickType_t UiConsumerTask::handler_pass(UiQueue& queue,
+                                        TickType_t wait,
+                                        std::uint32_t min_handler_period_ms)
+{
+    UiMessageView msg{};
+
+    // Block until a command arrives or LVGL has a timer due (animations, refresh)
+    const bool received = queue.receive(msg, wait);
+    const std::int64_t start_us = esp_timer_get_time();
+
+    const bool backlog = apply_commands(queue, received ? &msg : nullptr);
+    const TickType_t next_wait = run_timers(start_us, min_handler_period_ms);
+
+    // Bound reached: the rest of the backlog is handled by the next pass right away
+    return backlog ? 0 : next_wait;
+}
+
+bool UiConsumerTask::apply_commands(UiQueue& queue, UiMessageView* first)
+{
+    UiMessageView msg{};
+    bool received = first != nullptr;
+    if (first)
+    {
+        msg = *first;
+    }
+    else
+    {
+        received = queue.receive(msg, 0);
+    }
+
+    // Drain whatever else is already waiting, so a burst is rendered in one frame.
+    // State commands go through the mailbox, which keeps only the newest value of
+    // each widget.
+    std::uint32_t drained = 0;
+    while (received)
+    {
+        if (msg.type != UiCommandType::MailboxPosted)
         {
-            lv_obj_clear_flag(s_status_label, LV_OBJ_FLAG_HIDDEN);
+            (void)mailbox().post(msg.type, msg.payload, msg.submitted_us);
         }
+        queue.release(msg);
 
-        // DELETE QR container completely
-        if (s_qr_container)
+        if (++drained == CONFIG_UI_MAX_MESSAGES_PER_PASS)
         {
-            lv_obj_del(s_qr_container);
-            s_qr_container = nullptr;
-            s_qr_code = nullptr;
+            break;
         }
+        received = queue.receive(msg, 0);
+    }
+    if (drained > 0)
+    {
+        UiMetrics::record_drain(drained, queue.high_water());
+    }
+
+    // Only the newest value of each widget, once per pass
+    apply_mailbox();
+    return received;
+}
+
+void UiConsumerTask::apply_mailbox()
+{
+    std::array<UiMessageView, kMailboxSlots> latest;
+    const std::size_t count = mailbox().take(latest);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        handle_message(latest[i]);
+    }
+}
+
+TickType_t UiConsumerTask::run_timers(std::int64_t start_us, std::uint32_t min_handler_period_ms)
+{
+    // Takes the LVGL lock itself when LVGL is built with an OS layer
+    const std::uint32_t next_timer_ms = lv_timer_handler();
+    UiMetrics::record_handler_pass(static_cast<std::uint32_t>(esp_timer_get_time() - start_us));
+
+    if (next_timer_ms == LV_NO_TIMER_READY)
+    {
+        return portMAX_DELAY;
     }
+
+    const std::uint32_t sleep_ms = std::max(next_timer_ms, min_handler_period_ms);
+    return std::max<TickType_t>(pdMS_TO_TICKS(sleep_ms), 1);
 }
 
 void UiConsumerTask::lvgl_handler_task(void* arg)
 {
     auto* cfg = static_cast<const LvglTaskConfig*>(arg);
+    TickType_t wait = 0;
+
     auto* queue = static_cast<UiQueue*>(cfg->user_data);
-    UiMessage msg{};
 
+#if CONFIG_UI_UPDATE_MODE_LOCK
+    // Producers update widgets themselves; UiLock notifies this task on release
+    UiLock::set_render_task(xTaskGetCurrentTaskHandle());
     while (true)
     {
-        if (queue->receive(msg))
+        (void)ulTaskNotifyTakeIndexed(UiLock::kNotifyIndex, pdTRUE, wait);
+        const std::int64_t start_us = esp_timer_get_time();
+
+        // Only ISR submissions use the queue in this mode
+        bool backlog = false;
+        if (queue)
         {
-            switch (msg.type)
-            {
-            case UiCommandType::SetText:
-                if (s_counter_label)
-                {
-                    lv_label_set_text(s_counter_label, msg.text.data());
-                }
-                break;
-
-            case UiCommandType::SetStatus:
-                set_view_mode(false);
-                if (s_status_label)
-                {
-                    lv_label_set_text(s_status_label, msg.text.data());
-                }
-                break;
-
-            case UiCommandType::ShowQrCode:
-                if (!s_qr_code)
-                {
-                    // Create container
-                    s_qr_container = lv_obj_create(lv_scr_act());
-                    lv_obj_set_size(s_qr_container, 62, 62);
-                    lv_obj_set_style_bg_color(s_qr_container, lv_color_white(), 0);
-                    lv_obj_set_style_border_width(s_qr_container, 0, 0);
-                    lv_obj_set_style_radius(s_qr_container, 0, 0);
-                    lv_obj_set_style_pad_all(s_qr_container, 2, 0);
-                    lv_obj_center(s_qr_container);
-
-                    // Create QR inside container
-                    s_qr_code = lv_qrcode_create(s_qr_container);
-                    lv_qrcode_set_size(s_qr_code, 58);
-                    lv_qrcode_set_dark_color(s_qr_code, lv_color_black());
-                    lv_qrcode_set_light_color(s_qr_code, lv_color_white());
-                    lv_obj_center(s_qr_code);
-                }
-
-                lv_qrcode_update(s_qr_code, msg.text.data(), strlen(msg.text.data()));
-                set_view_mode(true);
-                break;
-
-            default:
-                break;
-            }
+            UiLock lock;
+            backlog = apply_commands(*queue, nullptr);
         }
 
-        lv_timer_handler();
-        vTaskDelay(pdMS_TO_TICKS(cfg->handler_period_ms));
+        wait = run_timers(start_us, cfg->min_handler_period_ms);
+        if (backlog)
+        {
+            wait = 0;
+        }
+    }
+#else
+    while (true)
+    {
+        wait = handler_pass(*queue, wait, cfg->min_handler_period_ms);
     }
+#endif
 }
 
 void UiConsumerTask::lvgl_tick_task(void* arg)
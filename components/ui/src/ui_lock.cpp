@@ -0,0 +1,61 @@
+#include "ui_lock.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+#include "lvgl.h"
+#include "ui_metrics.h"
+
+// UiLock::kNotifyIndex must exist next to index 0
+#if CONFIG_UI_UPDATE_MODE_LOCK && configTASK_NOTIFICATION_ARRAY_ENTRIES < 2
+#error "CONFIG_UI_UPDATE_MODE_LOCK needs FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 2"
+#endif
+
+namespace muc::ui
+{
+
+static std::atomic<TaskHandle_t> s_render_task{nullptr};
+
+UiLock::UiLock() noexcept
+: m_request_us(esp_timer_get_time())
+, m_acquired_us(0)
+{
+    lv_lock();
+    m_acquired_us = esp_timer_get_time();
+}
+
+UiLock::~UiLock()
+{
+    const std::int64_t released_us = esp_timer_get_time();
+    lv_unlock();
+
+    UiMetrics::record_lock(static_cast<std::uint32_t>(m_acquired_us - m_request_us),
+                           static_cast<std::uint32_t>(released_us - m_acquired_us));
+
+#if CONFIG_UI_UPDATE_MODE_LOCK
+    // The render task itself renders right after releasing anyway
+    TaskHandle_t task = s_render_task.load(std::memory_order_relaxed);
+    if (task && task != xTaskGetCurrentTaskHandle())
+    {
+        xTaskNotifyGiveIndexed(task, kNotifyIndex);
+    }
+#endif
+}
+
+void UiLock::set_render_task(TaskHandle_t task) noexcept
+{
+    s_render_task.store(task, std::memory_order_relaxed);
+}
+
+void UiLock::notify_render_task_from_isr(BaseType_t* higher_priority_task_woken) noexcept
+{
+    if (TaskHandle_t task = s_render_task.load(std::memory_order_relaxed))
+    {
+        vTaskNotifyGiveIndexedFromISR(task, kNotifyIndex, higher_priority_task_woken);
+    }
+}
+
+} // namespace muc::ui
@@ -0,0 +1,125 @@
+#include "ui_mailbox.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "ui_metrics.h"
+
+namespace muc::ui
+{
+
+UiMailbox::UiMailbox() noexcept
+{
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        m_slots[i].offset = offset;
+        offset += kMailboxSlotBytes[i] + 1;
+    }
+}
+
+bool UiMailbox::post(UiCommandType type,
+                     std::string_view payload,
+                     std::int64_t submitted_us) noexcept
+{
+    if (type == UiCommandType::MailboxPosted)
+    {
+        return false;
+    }
+    const auto index = static_cast<std::size_t>(slot_of(type));
+
+    const std::size_t length = std::min(payload.size(), kMailboxSlotBytes[index]);
+
+    bool superseded = false;
+    bool was_empty = false;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        Slot& slot = m_slots[index];
+
+        // Submitted before the value the slot already holds: obsolete on arrival
+        if (submitted_us < slot.submitted_us)
+        {
+            superseded = true;
+        }
+        else
+        {
+            superseded = slot.pending;
+            if (!slot.pending)
+            {
+                was_empty = m_pending == 0;
+                slot.pending = true;
+                m_pending++;
+            }
+
+            if (length > 0)
+            {
+                std::memcpy(&m_pool[slot.offset], payload.data(), length);
+            }
+            m_pool[slot.offset + length] = '\0';
+            slot.length = length;
+            slot.type = type;
+            slot.submitted_us = submitted_us;
+        }
+    }
+
+    if (superseded)
+    {
+        UiMetrics::record_superseded(lane_of(type));
+    }
+    return was_empty;
+}
+
+std::size_t UiMailbox::take(std::array<UiMessageView, kMailboxSlots>& out) noexcept
+{
+    std::size_t count = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_pending == 0)
+        {
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+        {
+            Slot& slot = m_slots[i];
+            if (!slot.pending)
+            {
+                continue;
+            }
+
+            std::memcpy(&m_taken[slot.offset], &m_pool[slot.offset], slot.length + 1);
+            out[count] = UiMessageView{.type = slot.type,
+                                      .submitted_us = slot.submitted_us,
+                                      .payload = std::string_view(&m_taken[slot.offset],
+                                                                  slot.length)};
+            count++;
+            slot.pending = false;
+        }
+        m_pending = 0;
+    }
+
+    // Urgent lane first, each lane replayed in submission order (e.g. a QR code shown
+    // before the status that hides it)
+    const auto before = [&](std::size_t a, std::size_t b)
+    {
+        const UiLane lane_a = lane_of(out[a].type);
+        const UiLane lane_b = lane_of(out[b].type);
+        if (lane_a != lane_b)
+        {
+            return lane_a < lane_b;
+        }
+        return out[a].submitted_us < out[b].submitted_us;
+    };
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        for (std::size_t j = i; j > 0 && before(j, j - 1); --j)
+        {
+            std::swap(out[j], out[j - 1]);
+        }
+    }
+    return count;
+}
+
+} // namespace muc::ui
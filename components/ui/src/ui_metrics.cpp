@@ -0,0 +1,181 @@
+#include "ui_metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+namespace muc::ui
+{
+
+// -----------------------------------------------------------------------------
+// State; producers, the LVGL task and monitor tasks all go through the mutex
+// -----------------------------------------------------------------------------
+static std::mutex s_mutex;
+static UiUpdateStats s_stats{};
+static std::uint64_t s_latency_total_us = 0;
+static std::uint64_t s_lock_hold_total_us = 0;
+static std::uint64_t s_drained_total = 0;
+
+// Per lane: oldest applied-but-not-yet-rendered update, 0 if none
+struct PendingLane
+{
+    std::int64_t since_us;
+    std::uint32_t updates;
+    std::uint64_t latency_total_us;
+};
+static std::array<PendingLane, kUiLanes> s_lanes{};
+
+// Refusals seen by UiApi::send_from_isr(), which cannot take the mutex
+static std::array<std::atomic<std::uint32_t>, kUiLanes> s_isr_refused{};
+
+void UiMetrics::attach(lv_display_t* disp) noexcept
+{
+    if (disp)
+    {
+        lv_display_add_event_cb(disp, render_ready_cb, LV_EVENT_RENDER_READY, nullptr);
+    }
+}
+
+void UiMetrics::applied(UiLane lane, std::int64_t submitted_us) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    PendingLane& pending = s_lanes[static_cast<std::size_t>(lane)];
+    if (pending.updates == 0 || submitted_us < pending.since_us)
+    {
+        pending.since_us = submitted_us;
+    }
+    pending.updates++;
+}
+
+void UiMetrics::render_ready_cb(lv_event_t*)
+{
+    const std::int64_t now = esp_timer_get_time();
+
+    std::lock_guard<std::mutex> guard(s_mutex);
+    for (std::size_t i = 0; i < kUiLanes; ++i)
+    {
+        PendingLane& pending = s_lanes[i];
+        if (pending.updates == 0)
+        {
+            continue;
+        }
+
+        // Coalesced updates share one frame; report the oldest one (worst case)
+        const auto latency_us = static_cast<std::uint32_t>(now - pending.since_us);
+        const std::uint64_t weighted_us = static_cast<std::uint64_t>(latency_us) * pending.updates;
+
+        UiLaneStats& lane = s_stats.lanes[i];
+        lane.updates += pending.updates;
+        pending.latency_total_us += weighted_us;
+        lane.latency_avg_us = static_cast<std::uint32_t>(pending.latency_total_us / lane.updates);
+        lane.latency_max_us = std::max(lane.latency_max_us, latency_us);
+
+        s_stats.updates += pending.updates;
+        s_latency_total_us += weighted_us;
+        s_stats.latency_avg_us = static_cast<std::uint32_t>(s_latency_total_us / s_stats.updates);
+        s_stats.latency_max_us = std::max(s_stats.latency_max_us, latency_us);
+
+        pending.updates = 0;
+        pending.since_us = 0;
+    }
+}
+
+void UiMetrics::record_superseded(UiLane lane) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.superseded++;
+    s_stats.lanes[static_cast<std::size_t>(lane)].superseded++;
+}
+
+void UiMetrics::record_refused(UiLane lane) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.lanes[static_cast<std::size_t>(lane)].refused++;
+}
+
+void UiMetrics::record_refused_from_isr(UiLane lane) noexcept
+{
+    s_isr_refused[static_cast<std::size_t>(lane)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void UiMetrics::record_unchanged() noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.unchanged++;
+}
+
+void UiMetrics::record_screen_heap(UiScreenId id, std::size_t bytes) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.screen_heap_bytes[static_cast<std::size_t>(id)] = static_cast<std::uint32_t>(bytes);
+}
+
+void UiMetrics::record_screen_switch() noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.screen_switches++;
+}
+
+void UiMetrics::record_producer(std::uint32_t busy_us) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.producer_busy_us += busy_us;
+}
+
+void UiMetrics::record_handler_pass(std::uint32_t busy_us) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.handler_busy_us += busy_us;
+    s_stats.handler_passes++;
+}
+
+void UiMetrics::record_drain(std::uint32_t messages, std::size_t queue_high_water) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.drain_passes++;
+    s_drained_total += messages;
+    s_stats.messages_per_pass_avg =
+        static_cast<std::uint32_t>(s_drained_total / s_stats.drain_passes);
+    s_stats.messages_per_pass_max = std::max(s_stats.messages_per_pass_max, messages);
+    s_stats.queue_high_water = static_cast<std::uint32_t>(queue_high_water);
+}
+
+void UiMetrics::record_lock(std::uint32_t wait_us, std::uint32_t hold_us) noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_stats.lock_acquisitions++;
+    // Anything above a few microseconds means lv_lock() actually blocked
+    if (wait_us > 5)
+    {
+        s_stats.lock_contended++;
+    }
+    s_stats.lock_wait_max_us = std::max(s_stats.lock_wait_max_us, wait_us);
+
+    s_lock_hold_total_us += hold_us;
+    s_stats.lock_hold_avg_us =
+        static_cast<std::uint32_t>(s_lock_hold_total_us / s_stats.lock_acquisitions);
+    s_stats.lock_hold_max_us = std::max(s_stats.lock_hold_max_us, hold_us);
+}
+
+UiUpdateStats UiMetrics::stats() noexcept
+{
+    std::lock_guard<std::mutex> guard(s_mutex);
+    UiUpdateStats out = s_stats;
+    for (std::size_t i = 0; i < kUiLanes; ++i)
+    {
+        out.lanes[i].refused += s_isr_refused[i].load(std::memory_order_relaxed);
+    }
+#if CONFIG_UI_UPDATE_MODE_LOCK
+    out.lock_mode = true;
+#else
+    out.lock_mode = false;
+#endif
+    return out;
+}
+
+} // namespace muc::ui
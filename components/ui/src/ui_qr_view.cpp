@@ -0,0 +1,244 @@
+#include "ui_qr_view.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+#include "src/libs/qrcode/qrcodegen.h"
+#include "ui_widget_registry.h"
+
+#if CONFIG_UI_QR_CACHE_NVS
+#include <nvs.h>
+#endif
+
+namespace muc::ui
+{
+
+namespace
+{
+constexpr const char* TAG = "UiQrView";
+
+// Encoder scratch space: input data and working area, sized for kQrMaxVersion
+std::array<std::uint8_t, kQrSymbolBytes> s_encoder_temp;
+
+#if CONFIG_UI_QR_CACHE_NVS
+constexpr const char* kNvsNamespace = "ui_qr";
+constexpr const char* kNvsKey = "last";
+
+// Blob: payload length (4 bytes), payload padded to kQrMaxPayloadBytes, symbol. A hit
+// needs the very same payload bytes.
+constexpr std::size_t kNvsBlobBytes = 4 + kQrMaxPayloadBytes + kQrSymbolBytes;
+
+bool load_from_nvs(std::string_view payload, std::uint8_t* symbol)
+{
+    nvs_handle_t handle;
+    if (nvs_open(kNvsNamespace, NVS_READONLY, &handle) != ESP_OK)
+    {
+        return false;
+    }
+
+    std::array<std::uint8_t, kNvsBlobBytes> blob;
+    std::size_t size = blob.size();
+    const bool found = nvs_get_blob(handle, kNvsKey, blob.data(), &size) == ESP_OK &&
+                       size == blob.size();
+    nvs_close(handle);
+
+    std::uint32_t stored_length = 0;
+    std::memcpy(&stored_length, &blob[0], 4);
+    if (!found || stored_length != payload.size() ||
+        (!payload.empty() && std::memcmp(&blob[4], payload.data(), payload.size()) != 0))
+    {
+        return false;
+    }
+
+    std::memcpy(symbol, &blob[4 + kQrMaxPayloadBytes], kQrSymbolBytes);
+    return true;
+}
+
+void store_to_nvs(std::string_view payload, const std::uint8_t* symbol)
+{
+    nvs_handle_t handle;
+    if (nvs_open(kNvsNamespace, NVS_READWRITE, &handle) != ESP_OK)
+    {
+        return;
+    }
+
+    std::array<std::uint8_t, kNvsBlobBytes> blob{};
+    const auto stored_length = static_cast<std::uint32_t>(payload.size());
+    std::memcpy(&blob[0], &stored_length, 4);
+    if (!payload.empty())
+    {
+        std::memcpy(&blob[4], payload.data(), payload.size());
+    }
+    std::memcpy(&blob[4 + kQrMaxPayloadBytes], symbol, kQrSymbolBytes);
+
+    if (nvs_set_blob(handle, kNvsKey, blob.data(), blob.size()) == ESP_OK)
+    {
+        (void)nvs_commit(handle);
+    }
+    nvs_close(handle);
+}
+#endif
+} // namespace
+
+lv_obj_t* UiQrView::create(lv_obj_t* parent) noexcept
+{
+    // Palette: index 0 light, index 1 dark; every pixel starts light
+    const lv_color32_t palette[2] = {lv_color_to_32(lv_color_white(), LV_OPA_COVER),
+                                     lv_color_to_32(lv_color_black(), LV_OPA_COVER)};
+    std::memcpy(m_pixels.data(), palette, kPaletteBytes);
+
+    m_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    m_dsc.header.cf = LV_COLOR_FORMAT_I1;
+    m_dsc.header.w = kQrViewPixels;
+    m_dsc.header.h = kQrViewPixels;
+    m_dsc.header.stride = kStrideBytes;
+    m_dsc.data_size = m_pixels.size();
+    m_dsc.data = m_pixels.data();
+
+    m_image = lv_image_create(parent);
+    lv_image_set_src(m_image, &m_dsc);
+    lv_obj_set_user_data(m_image, this);
+    return m_image;
+}
+
+bool UiQrView::set_payload(std::string_view payload) noexcept
+{
+    const std::uint32_t hash = payload_hash(payload);
+
+    const CacheEntry* entry = lookup(payload, hash);
+    if (!entry)
+    {
+        entry = encode(payload, hash);
+    }
+
+    render(entry);
+    return entry != nullptr;
+}
+
+bool UiQrView::shows(std::string_view payload) const noexcept
+{
+    return m_shown && m_shown->holds(payload, payload_hash(payload));
+}
+
+bool UiQrView::CacheEntry::holds(std::string_view value, std::uint32_t value_hash) const noexcept
+{
+    return valid && hash == value_hash && length == value.size() &&
+           (value.empty() || std::memcmp(payload.data(), value.data(), value.size()) == 0);
+}
+
+const UiQrView::CacheEntry* UiQrView::lookup(std::string_view payload,
+                                             std::uint32_t hash) const noexcept
+{
+    for (const CacheEntry& entry : m_cache)
+    {
+        if (entry.holds(payload, hash))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const UiQrView::CacheEntry* UiQrView::encode(std::string_view payload,
+                                             std::uint32_t hash) noexcept
+{
+    const std::size_t length = payload.size();
+    if (length > kQrMaxPayloadBytes)
+    {
+        ESP_LOGW(TAG, "QR payload too long (%u bytes)", static_cast<unsigned>(length));
+        return nullptr;
+    }
+
+    CacheEntry& entry = m_cache[m_next_entry];
+    entry.valid = false;
+
+#if CONFIG_UI_QR_CACHE_NVS
+    if (load_from_nvs(payload, entry.symbol.data()))
+    {
+        ESP_LOGD(TAG, "QR code restored from NVS");
+    }
+    else
+#endif
+    {
+        const std::int64_t start_us = esp_timer_get_time();
+        if (length > 0)
+        {
+            std::memcpy(s_encoder_temp.data(), payload.data(), length);
+        }
+        if (!qrcodegen_encodeBinary(s_encoder_temp.data(),
+                                    length,
+                                    entry.symbol.data(),
+                                    qrcodegen_Ecc_MEDIUM,
+                                    qrcodegen_VERSION_MIN,
+                                    kQrMaxVersion,
+                                    qrcodegen_Mask_AUTO,
+                                    true))
+        {
+            ESP_LOGW(TAG, "QR payload does not fit version %d", kQrMaxVersion);
+            return nullptr;
+        }
+        ESP_LOGD(TAG,
+                 "QR code encoded in %lld us",
+                 static_cast<long long>(esp_timer_get_time() - start_us));
+
+#if CONFIG_UI_QR_CACHE_NVS
+        store_to_nvs(payload, entry.symbol.data());
+#endif
+    }
+
+    if (length > 0)
+    {
+        std::memcpy(entry.payload.data(), payload.data(), length);
+    }
+    entry.hash = hash;
+    entry.length = static_cast<std::uint16_t>(length);
+    entry.valid = true;
+    m_next_entry = (m_next_entry + 1) % m_cache.size();
+    return &entry;
+}
+
+void UiQrView::render(const CacheEntry* entry) noexcept
+{
+    std::uint8_t* rows = m_pixels.data() + kPaletteBytes;
+    std::fill(rows, m_pixels.data() + m_pixels.size(), 0);
+    m_shown = entry;
+
+    if (entry)
+    {
+        const std::uint8_t* symbol = entry->symbol.data();
+        // Largest integer scale that fits, centered; the border stays light (quiet zone)
+        const int modules = qrcodegen_getSize(symbol);
+        const int scale = std::max(1, static_cast<int>(kQrViewPixels) / modules);
+        const int offset = std::max(0, (static_cast<int>(kQrViewPixels) - modules * scale) / 2);
+
+        for (int y = 0; y < modules; ++y)
+        {
+            for (int x = 0; x < modules; ++x)
+            {
+                if (!qrcodegen_getModule(symbol, x, y))
+                {
+                    continue;
+                }
+
+                for (int py = offset + y * scale; py < offset + (y + 1) * scale; ++py)
+                {
+                    std::uint8_t* row = rows + py * kStrideBytes;
+                    for (int px = offset + x * scale; px < offset + (x + 1) * scale; ++px)
+                    {
+                        row[px >> 3] |= static_cast<std::uint8_t>(0x80u >> (px & 7));
+                    }
+                }
+            }
+        }
+    }
+
+    // Same descriptor, new pixels: drop any cached decode and redraw
+    lv_image_cache_drop(&m_dsc);
+    lv_obj_invalidate(m_image);
+}
+
+} // namespace muc::ui
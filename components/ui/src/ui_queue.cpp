@@ -1,9 +1,10 @@
 #include "ui_queue.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 
-#include "ui_api.h"
+#include <esp_timer.h>
 
 namespace muc::ui
 {
@@ -11,50 +12,319 @@ namespace muc::ui
 void UiMessage::set_payload(std::string_view sv)
 {
     size_t len = std::min(sv.length(), text.size() - 1);
-    std::memcpy(text.data(), sv.data(), len);
+    if (len > 0)
+    {
+        std::memcpy(text.data(), sv.data(), len);
+    }
     text[len] = '\0';
+    length = static_cast<std::uint8_t>(len);
 }
 
-UiApi::UiApi(UiQueue& queue)
-: m_queue(queue)
+bool UiQueue::send(UiCommandType type,
+                   std::string_view payload,
+                   std::int64_t submitted_us,
+                   UiLane lane)
 {
+    UiReservation reservation;
+    if (!reserve(type, payload.size(), submitted_us, lane, reservation))
+    {
+        return false;
+    }
+
+    if (reservation.size() > 0)
+    {
+        std::memcpy(reservation.payload(), payload.data(), reservation.size());
+    }
+    return commit(reservation);
 }
 
-void UiApi::set_text(std::string_view text)
+void UiQueue::count_sent() noexcept
 {
-    UiMessage msg;
-    msg.type = UiCommandType::SetText;
+    const std::size_t depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::size_t high = m_high_water.load(std::memory_order_relaxed);
+    while (depth > high &&
+           !m_high_water.compare_exchange_weak(high, depth, std::memory_order_relaxed))
+    {
+    }
+}
+
+#if CONFIG_UI_QUEUE_BACKEND_RING || CONFIG_UI_QUEUE_BACKEND_FREERTOS
+// -----------------------------------------------------------------------------
+// Fixed-size backends: a UiMessage is staged by the producer and copied through
+// -----------------------------------------------------------------------------
+UiQueue::UiQueue(size_t queue_size)
+: m_bulk_limit(queue_size - std::max<std::size_t>(queue_size / 4, 1))
+{
+#if CONFIG_UI_QUEUE_BACKEND_RING
+    configASSERT(queue_size <= kUiQueueRingCapacity);
+#else
+    m_handle = xQueueCreate(queue_size, sizeof(UiMessage));
+#endif
+}
+
+bool UiQueue::reserve(UiCommandType type,
+                      std::size_t length,
+                      std::int64_t submitted_us,
+                      UiLane lane,
+                      UiReservation& reservation)
+{
+    if (lane == UiLane::Bulk && m_depth.load(std::memory_order_relaxed) >= m_bulk_limit)
+    {
+        return false;
+    }
 
-    // Manual copy instead of .set_payload()
-    size_t len = std::min(text.length(), msg.text.size() - 1);
-    std::memcpy(msg.text.data(), text.data(), len);
-    msg.text[len] = '\0';
+    UiMessage& msg = reservation.m_staging;
+    msg.type = type;
+    msg.submitted_us = submitted_us;
 
-    m_queue.send(msg);
+    reservation.m_payload = msg.text.data();
+    reservation.m_size = std::min(length, msg.text.size() - 1);
+    return true;
 }
 
-void UiApi::set_status(std::string_view status)
+bool UiQueue::commit(UiReservation& reservation)
 {
-    UiMessage msg;
-    msg.type = UiCommandType::SetStatus;
+    UiMessage& msg = reservation.m_staging;
+    msg.text[reservation.m_size] = '\0';
+    msg.length = static_cast<std::uint8_t>(reservation.m_size);
 
-    size_t len = std::min(status.length(), msg.text.size() - 1);
-    std::memcpy(msg.text.data(), status.data(), len);
-    msg.text[len] = '\0';
+    // Counted before the send so the consumer never sees a negative depth
+    count_sent();
+#if CONFIG_UI_QUEUE_BACKEND_RING
+    const bool sent = m_ring.send(msg);
+#else
+    const bool sent = xQueueSend(m_handle, &msg, 0) == pdTRUE;
+#endif
+    if (!sent)
+    {
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return sent;
+}
 
-    m_queue.send(msg);
+bool UiQueue::receive(UiMessageView& view, TickType_t timeout)
+{
+#if CONFIG_UI_QUEUE_BACKEND_RING
+    const bool received = m_ring.receive(m_rx, timeout);
+#else
+    const bool received = xQueueReceive(m_handle, &m_rx, timeout) == pdTRUE;
+#endif
+    if (!received)
+    {
+        return false;
+    }
+
+    m_depth.fetch_sub(1, std::memory_order_relaxed);
+    view = {.type = m_rx.type,
+            .submitted_us = m_rx.submitted_us,
+            .payload = std::string_view(m_rx.text.data(), m_rx.length)};
+    return true;
 }
 
-void UiApi::show_provision_qr(std::string_view payload)
+void UiQueue::release(const UiMessageView&)
 {
+}
+
+bool UiQueue::send_from_isr(UiCommandType type,
+                            std::string_view payload,
+                            std::int64_t submitted_us,
+                            UiLane lane,
+                            BaseType_t* higher_priority_task_woken)
+{
+    if (lane == UiLane::Bulk && m_depth.load(std::memory_order_relaxed) >= m_bulk_limit)
+    {
+        return false;
+    }
+
+    // Staged whole on the ISR stack: queue items and ring slots are UiMessages
     UiMessage msg;
-    msg.type = UiCommandType::ShowQrCode;
+    msg.type = type;
+    msg.submitted_us = submitted_us;
+    const std::size_t length = std::min(payload.size(), kUiIsrMaxPayloadBytes);
+    if (length > 0)
+    {
+        std::memcpy(msg.text.data(), payload.data(), length);
+    }
+    msg.text[length] = '\0';
+    msg.length = static_cast<std::uint8_t>(length);
+
+    count_sent();
+#if CONFIG_UI_QUEUE_BACKEND_RING
+    const bool sent = m_ring.send_from_isr(msg, higher_priority_task_woken);
+#else
+    const bool sent = xQueueSendFromISR(m_handle, &msg, higher_priority_task_woken) == pdTRUE;
+#endif
+    if (!sent)
+    {
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return sent;
+}
+
+#else
+// -----------------------------------------------------------------------------
+// Byte stream: variable-length records in an ESP-IDF no-split ring buffer
+// -----------------------------------------------------------------------------
+namespace
+{
+// 8 bytes in front of every payload. Only the low 32 bits of the submit time are
+// stored; the consumer rebuilds the full value (latencies are far below 71 minutes).
+struct RecordHeader
+{
+    UiCommandType type;
+    std::uint8_t reserved;
+    std::uint16_t length;
+    std::uint32_t submitted_us;
+};
+static_assert(sizeof(RecordHeader) == 8);
+
+// Free bytes the bulk lane leaves to urgent records
+constexpr std::size_t kUrgentReserveBytes = CONFIG_UI_QUEUE_STREAM_BYTES / 4;
+
+// Ring buffer space of an item: 8-byte item header, size rounded up to 4
+constexpr std::size_t accounted_bytes(std::size_t item_size)
+{
+    return 8 + ((item_size + 3) & ~std::size_t{3});
+}
+} // namespace
+
+bool UiQueue::admits(UiLane lane, std::size_t record_bytes) const noexcept
+{
+    const std::size_t used = m_used_bytes.load(std::memory_order_relaxed);
+    const std::size_t reserve = lane == UiLane::Bulk ? kUrgentReserveBytes : 0;
+    return used + accounted_bytes(record_bytes) + reserve <= CONFIG_UI_QUEUE_STREAM_BYTES;
+}
+
+UiQueue::UiQueue(size_t)
+{
+    m_handle = xRingbufferCreate(CONFIG_UI_QUEUE_STREAM_BYTES, RINGBUF_TYPE_NOSPLIT);
+    configASSERT(m_handle);
+}
+
+bool UiQueue::reserve(UiCommandType type,
+                      std::size_t length,
+                      std::int64_t submitted_us,
+                      UiLane lane,
+                      UiReservation& reservation)
+{
+    length = std::min(length, kUiMaxPayloadBytes);
+
+    // Header, payload and its NUL terminator
+    const std::size_t record_bytes = sizeof(RecordHeader) + length + 1;
+    if (!admits(lane, record_bytes))
+    {
+        return false;
+    }
+
+    void* item = nullptr;
+    if (xRingbufferSendAcquire(m_handle, &item, record_bytes, 0) != pdTRUE)
+    {
+        return false;
+    }
+    m_used_bytes.fetch_add(accounted_bytes(record_bytes), std::memory_order_relaxed);
+
+    const RecordHeader header{.type = type,
+                              .reserved = 0,
+                              .length = static_cast<std::uint16_t>(length),
+                              .submitted_us = static_cast<std::uint32_t>(submitted_us)};
+    std::memcpy(item, &header, sizeof(header));
+
+    reservation.m_item = item;
+    reservation.m_payload = static_cast<char*>(item) + sizeof(RecordHeader);
+    reservation.m_size = length;
+    return true;
+}
+
+bool UiQueue::commit(UiReservation& reservation)
+{
+    reservation.m_payload[reservation.m_size] = '\0';
+    count_sent();
+    const bool sent = xRingbufferSendComplete(m_handle, reservation.m_item) == pdTRUE;
+    reservation.m_item = nullptr;
+    if (!sent)
+    {
+        // Give back what reserve() accounted, as send_from_isr() does
+        const std::size_t record_bytes = sizeof(RecordHeader) + reservation.m_size + 1;
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+        m_used_bytes.fetch_sub(accounted_bytes(record_bytes), std::memory_order_relaxed);
+    }
+    return sent;
+}
+
+bool UiQueue::receive(UiMessageView& view, TickType_t timeout)
+{
+    std::size_t size = 0;
+    void* item = xRingbufferReceive(m_handle, &size, timeout);
+    if (!item)
+    {
+        return false;
+    }
+
+    m_depth.fetch_sub(1, std::memory_order_relaxed);
+
+    RecordHeader header;
+    std::memcpy(&header, item, sizeof(header));
+
+    const std::int64_t now = esp_timer_get_time();
+    const auto age_us = static_cast<std::uint32_t>(static_cast<std::uint32_t>(now) -
+                                                   header.submitted_us);
+
+    m_rx_item = item;
+    m_rx_bytes = size;
+    view = {.type = header.type,
+            .submitted_us = now - age_us,
+            .payload = std::string_view(static_cast<const char*>(item) + sizeof(RecordHeader),
+                                        header.length)};
+    return true;
+}
+
+void UiQueue::release(const UiMessageView&)
+{
+    if (m_rx_item)
+    {
+        vRingbufferReturnItem(m_handle, m_rx_item);
+        m_used_bytes.fetch_sub(accounted_bytes(m_rx_bytes), std::memory_order_relaxed);
+        m_rx_item = nullptr;
+    }
+}
+
+bool UiQueue::send_from_isr(UiCommandType type,
+                            std::string_view payload,
+                            std::int64_t submitted_us,
+                            UiLane lane,
+                            BaseType_t* higher_priority_task_woken)
+{
+    const std::size_t length = std::min(payload.size(), kUiIsrMaxPayloadBytes);
+    const std::size_t record_bytes = sizeof(RecordHeader) + length + 1;
+    if (!admits(lane, record_bytes))
+    {
+        return false;
+    }
 
-    size_t len = std::min(payload.length(), msg.text.size() - 1);
-    std::memcpy(msg.text.data(), payload.data(), len);
-    msg.text[len] = '\0';
+    // The record is assembled on the ISR stack and copied in one go
+    std::array<std::uint8_t, sizeof(RecordHeader) + kUiIsrMaxPayloadBytes + 1> record;
+    const RecordHeader header{.type = type,
+                              .reserved = 0,
+                              .length = static_cast<std::uint16_t>(length),
+                              .submitted_us = static_cast<std::uint32_t>(submitted_us)};
+    std::memcpy(record.data(), &header, sizeof(header));
+    if (length > 0)
+    {
+        std::memcpy(record.data() + sizeof(header), payload.data(), length);
+    }
+    record[sizeof(header) + length] = '\0';
 
-    m_queue.send(msg);
+    m_used_bytes.fetch_add(accounted_bytes(record_bytes), std::memory_order_relaxed);
+    count_sent();
+    if (xRingbufferSendFromISR(m_handle, record.data(), record_bytes, higher_priority_task_woken) !=
+        pdTRUE)
+    {
+        m_depth.fetch_sub(1, std::memory_order_relaxed);
+        m_used_bytes.fetch_sub(accounted_bytes(record_bytes), std::memory_order_relaxed);
+        return false;
+    }
+    return true;
 }
+#endif
 
-} // namespace muc::ui
\ No newline at end of file
+} // namespace muc::ui
@@ -0,0 +1,60 @@
+#include "ui_screens.h"
+
+#include "ui_metrics.h"
+
+namespace muc::ui
+{
+
+namespace
+{
+std::size_t lvgl_heap_used() noexcept
+{
+    lv_mem_monitor_t mon{};
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+} // namespace
+
+void UiScreenManager::build(UiScreenId id, lv_obj_t* root, BuildFn build) noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    if (index >= m_screens.size() || m_screens[index])
+    {
+        return;
+    }
+
+    const std::size_t used_before = lvgl_heap_used();
+
+    lv_obj_t* screen = root ? root : lv_obj_create(nullptr);
+    build(screen);
+    m_screens[index] = screen;
+    if (lv_screen_active() == screen)
+    {
+        m_active = screen;
+    }
+
+    const std::size_t used_after = lvgl_heap_used();
+    UiMetrics::record_screen_heap(id, used_after > used_before ? used_after - used_before : 0);
+}
+
+bool UiScreenManager::show(UiScreenId id) noexcept
+{
+    lv_obj_t* screen = this->screen(id);
+    if (!screen || screen == m_active)
+    {
+        return false;
+    }
+
+    lv_screen_load(screen);
+    m_active = screen;
+    UiMetrics::record_screen_switch();
+    return true;
+}
+
+lv_obj_t* UiScreenManager::screen(UiScreenId id) const noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    return index < m_screens.size() ? m_screens[index] : nullptr;
+}
+
+} // namespace muc::ui
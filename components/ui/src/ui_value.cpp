@@ -0,0 +1,82 @@
+#include "ui_value.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+
+namespace muc::ui
+{
+
+namespace
+{
+// Decimal text of raw / 10^decimals, e.g. (-5, 2) -> "-0.05"
+std::size_t format_fixed(std::int32_t raw, std::uint8_t decimals, std::span<char> out) noexcept
+{
+    decimals = std::min<std::uint8_t>(decimals, 9);
+
+    // Magnitude, zero-padded to at least one digit before the decimal point
+    std::array<char, 16> digits;
+    std::fill(digits.begin(), digits.end(), '0');
+    const std::int64_t magnitude = raw < 0 ? -static_cast<std::int64_t>(raw) : raw;
+    std::array<char, 16> plain;
+    const auto result = std::to_chars(plain.data(), plain.data() + plain.size(), magnitude);
+    const auto plain_count = static_cast<std::size_t>(result.ptr - plain.data());
+    const std::size_t count = std::max<std::size_t>(plain_count, decimals + 1u);
+    std::memcpy(digits.data() + count - plain_count, plain.data(), plain_count);
+
+    std::array<char, 20> text;
+    std::size_t length = 0;
+    if (raw < 0)
+    {
+        text[length++] = '-';
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i == count - decimals)
+        {
+            text[length++] = '.';
+        }
+        text[length++] = digits[i];
+    }
+
+    length = std::min(length, out.size());
+    std::memcpy(out.data(), text.data(), length);
+    return length;
+}
+} // namespace
+
+std::size_t format_number(const UiNumber& number, std::span<char> out) noexcept
+{
+    if (out.empty())
+    {
+        return 0;
+    }
+
+    const std::size_t capacity = out.size() - 1;
+    std::size_t length = 0;
+    const auto append = [&](const char* text, std::size_t size)
+    {
+        size = std::min(size, capacity - length);
+        std::memcpy(out.data() + length, text, size);
+        length += size;
+    };
+
+    const char* format = number.format ? number.format : "{}";
+    const char* placeholder = std::strstr(format, "{}");
+    const std::size_t prefix = placeholder ? placeholder - format : std::strlen(format);
+    append(format, prefix);
+
+    if (placeholder)
+    {
+        std::array<char, 32> value;
+        append(value.data(), format_fixed(number.raw, number.decimals, value));
+        const char* suffix = placeholder + 2;
+        append(suffix, std::strlen(suffix));
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+} // namespace muc::ui
@@ -0,0 +1,117 @@
+#include "ui_widget_registry.h"
+
+#include <cstring>
+
+#include "ui_qr_view.h"
+
+namespace muc::ui
+{
+
+std::uint32_t payload_hash(std::string_view value) noexcept
+{
+    std::uint32_t hash = 2166136261u;
+    for (char c : value)
+    {
+        hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+void UiWidgetRegistry::add(UiWidgetId id, lv_obj_t* obj, UiWidgetKind kind) noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    if (index >= m_entries.size() || !obj)
+    {
+        return;
+    }
+
+    Entry& entry = m_entries[index];
+    entry = Entry{.obj = obj, .kind = kind, .has_number = false, .number = {}};
+    lv_obj_add_event_cb(obj, delete_cb, LV_EVENT_DELETE, &entry);
+}
+
+lv_obj_t* UiWidgetRegistry::get(UiWidgetId id) const noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    return index < m_entries.size() ? m_entries[index].obj : nullptr;
+}
+
+bool UiWidgetRegistry::set_value(UiWidgetId id, std::string_view value) noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    if (index >= m_entries.size() || !m_entries[index].obj)
+    {
+        return false;
+    }
+
+    Entry& entry = m_entries[index];
+    switch (entry.kind)
+    {
+    case UiWidgetKind::Label:
+        entry.has_number = false; // no longer showing a number
+        return set_label_text(entry.obj, value);
+
+    case UiWidgetKind::QrCode:
+    {
+        auto* view = static_cast<UiQrView*>(lv_obj_get_user_data(entry.obj));
+        if (view->shows(value))
+        {
+            return false;
+        }
+        view->set_payload(value);
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+bool UiWidgetRegistry::set_number(UiWidgetId id, const UiNumber& number) noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    if (index >= m_entries.size() || !m_entries[index].obj ||
+        m_entries[index].kind != UiWidgetKind::Label)
+    {
+        return false;
+    }
+
+    // UiNumber has no padding, so equal values have equal bytes
+    Entry& entry = m_entries[index];
+    if (entry.has_number && std::memcmp(&entry.number, &number, sizeof(number)) == 0)
+    {
+        return false;
+    }
+
+    std::array<char, kUiNumberTextBytes> text;
+    const std::size_t length = format_number(number, text);
+    entry.has_number = true;
+    entry.number = number;
+    return set_label_text(entry.obj, std::string_view(text.data(), length));
+}
+
+bool UiWidgetRegistry::set_label_text(lv_obj_t* label, std::string_view text) noexcept
+{
+    // The label owns a copy of its text: compare exactly
+    const char* shown = lv_label_get_text(label);
+    if (shown && std::strlen(shown) == text.size() &&
+        std::memcmp(shown, text.data(), text.size()) == 0)
+    {
+        return false;
+    }
+    lv_label_set_text(label, text.data());
+    return true;
+}
+
+void UiWidgetRegistry::delete_cb(lv_event_t* e)
+{
+    // The ID may have been re-registered for a newer object in the meantime
+    auto* entry = static_cast<Entry*>(lv_event_get_user_data(e));
+    if (entry->obj == lv_event_get_target(e))
+    {
+        entry->obj = nullptr;
+        entry->has_number = false;
+    }
+}
+
+} // namespace muc::ui
@@ -0,0 +1,367 @@
+// Rotated text benchmark: fixed-point blit_affine() vs. the floating-point forward mapping
+// font_rotate_task used before.
+//
+// "Grüße" at 16 px is drawn upright once, then rotated onto the 72x40 screen at the demo's
+// 24 angles (15 degree steps). For every angle both methods are compared against a
+// double-precision inverse-mapping reference (each screen pixel centre mapped into the
+// text and sampled):
+//   holes:    reference pixels a method leaves dark
+//   extra:    pixels a method lights that the reference does not
+// blit_affine() may only differ from the reference where a pixel centre lands within
+// kEdge of a source pixel edge, where Q16.16 rounding can tip it either way. At right
+// angles the whole-pixel centres map pixel centres onto pixel centres, so there it must
+// match exactly, checked on the demo text (44x13) and on an odd-by-odd test pattern. Any
+// other difference, a sin/cos table error above one Q16 step, or an inverse that wraps
+// instead of failing (near-singular scaling), exits non-zero.
+//
+// Then times one frame (clear excluded) of each method, averaged over all angles, best of
+// several runs. The host has a hardware double FPU; the ESP32-C3 does not, so there every
+// double operation of the forward mapping is a soft-float library call.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "Affine.h"
+#include "FontAtlas.h"
+#include "II2CDevice.h"
+#include "TextLayout.h"
+#include "TextRenderer.h"
+#include "ssd1306.h"
+
+namespace
+{
+
+using muc::fonts::Affine;
+using muc::fonts::AtlasFont;
+using muc::fonts::blit_affine;
+using muc::fonts::PageBitmap;
+using muc::fonts::to_fixed;
+using muc::ssd1306::kDefaultGeometry;
+using muc::ssd1306::Oled;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kEdge = 1.0 / 256.0;
+constexpr double kPi = 3.14159265358979323846;
+
+class NullDevice : public muc::II2CDevice
+{
+  public:
+    esp_err_t write(std::span<const std::uint8_t>) noexcept override
+    {
+        return ESP_OK;
+    }
+
+    esp_err_t read(std::span<std::uint8_t>) noexcept override
+    {
+        return ESP_OK;
+    }
+};
+
+// Where the demo puts the text: its centre at the screen centre, 4 px up
+struct Placement
+{
+    double text_cx;
+    double text_cy;
+    double screen_cx;
+    double screen_cy;
+};
+
+// --- Previous renderer --------------------------------------------------------
+// Every set text pixel is rotated forwards and plotted; pixels in between stay dark
+void forward_rotate(Oled& oled, const PageBitmap& text, const Placement& at, int degrees)
+{
+    const double rad = -(degrees * kPi / 180.0);
+    const double cos_a = std::cos(rad);
+    const double sin_a = std::sin(rad);
+    for (int row = 0; row < text.height; ++row)
+    {
+        for (int col = 0; col < text.width; ++col)
+        {
+            if (text.pixel(col, row))
+            {
+                const double rx = col - at.text_cx;
+                const double ry = at.text_cy - row;
+                const double rot_x = rx * cos_a - ry * sin_a;
+                const double rot_y = rx * sin_a + ry * cos_a;
+                oled.drawPixel(static_cast<int>(at.screen_cx + rot_x),
+                               static_cast<int>(at.screen_cy - rot_y),
+                               true);
+            }
+        }
+    }
+}
+
+// --- Reference ----------------------------------------------------------------
+// Sets `near_edge` where the sampled source position is within kEdge of a pixel edge
+void reference_rotate(const PageBitmap& screen,
+                      const PageBitmap& near_edge,
+                      const PageBitmap& text,
+                      const Placement& at,
+                      int degrees)
+{
+    const double rad = degrees * kPi / 180.0;
+    const double cos_a = std::cos(rad);
+    const double sin_a = std::sin(rad);
+    for (int y = 0; y < screen.height; ++y)
+    {
+        for (int x = 0; x < screen.width; ++x)
+        {
+            // Inverse rotation of the pixel centre
+            const double dx = x + 0.5 - at.screen_cx;
+            const double dy = y + 0.5 - at.screen_cy;
+            const double fx = dx * cos_a + dy * sin_a + at.text_cx;
+            const double fy = -dx * sin_a + dy * cos_a + at.text_cy;
+            const double sx = std::floor(fx);
+            const double sy = std::floor(fy);
+            const auto bit = static_cast<std::uint8_t>(1u << (y & 7));
+            if (sx >= 0 && sy >= 0 && sx < text.width && sy < text.height &&
+                text.pixel(static_cast<int>(sx), static_cast<int>(sy)))
+            {
+                screen.data[(y >> 3) * screen.width + x] |= bit;
+            }
+            if (std::abs(fx - std::round(fx)) < kEdge || std::abs(fy - std::round(fy)) < kEdge)
+            {
+                near_edge.data[(y >> 3) * near_edge.width + x] |= bit;
+            }
+        }
+    }
+}
+
+// Same whole-pixel centres as font_rotate_task
+Affine demo_transform(const PageBitmap& text, const PageBitmap& screen, int degrees)
+{
+    return Affine::translation(to_fixed(screen.width / 2), to_fixed(screen.height / 2 - 4)) *
+           Affine::rotation(degrees) *
+           Affine::translation(-to_fixed(text.width / 2), -to_fixed(text.height / 2));
+}
+
+Placement demo_placement(const PageBitmap& text)
+{
+    return Placement{.text_cx = static_cast<double>(text.width / 2),
+                     .text_cy = static_cast<double>(text.height / 2),
+                     .screen_cx = static_cast<double>(kDefaultGeometry.width / 2),
+                     .screen_cy = static_cast<double>(kDefaultGeometry.height / 2 - 4)};
+}
+
+struct Difference
+{
+    int holes;
+    int extra;
+    int unexcused; // differences away from a source pixel edge
+};
+
+Difference compare(const PageBitmap& reference,
+                   const PageBitmap& near_edge,
+                   const PageBitmap& actual)
+{
+    Difference d{};
+    for (int y = 0; y < reference.height; ++y)
+    {
+        for (int x = 0; x < reference.width; ++x)
+        {
+            const bool want = reference.pixel(x, y);
+            const bool got = actual.pixel(x, y);
+            d.holes += want && !got;
+            d.extra += got && !want;
+            d.unexcused += want != got && !near_edge.pixel(x, y);
+        }
+    }
+    return d;
+}
+
+int check_trig()
+{
+    constexpr double kFixed = muc::fonts::kFixedOne;
+    int failures = 0;
+    for (int degrees = -720; degrees <= 720; ++degrees)
+    {
+        const double rad = degrees * kPi / 180.0;
+        const double sin_err = std::abs(muc::fonts::sin_fixed(degrees) - std::sin(rad) * kFixed);
+        const double cos_err = std::abs(muc::fonts::cos_fixed(degrees) - std::cos(rad) * kFixed);
+        if (sin_err > 1.0 || cos_err > 1.0)
+        {
+            if (failures++ < 10)
+            {
+                std::printf("MISMATCH: sin/cos(%d) off by %.1f/%.1f\n", degrees, sin_err, cos_err);
+            }
+        }
+    }
+    return failures;
+}
+
+int check_right_angles(const char* what, const PageBitmap& text)
+{
+    NullDevice devices[3];
+    Oled reference(devices[0], kDefaultGeometry);
+    Oled edges(devices[1], kDefaultGeometry);
+    Oled fixed(devices[2], kDefaultGeometry);
+    const PageBitmap reference_screen = muc::fonts::page_bitmap(reference);
+    const PageBitmap edge_screen = muc::fonts::page_bitmap(edges);
+    const PageBitmap fixed_screen = muc::fonts::page_bitmap(fixed);
+
+    int failures = 0;
+    for (int degrees = 0; degrees < 360; degrees += 90)
+    {
+        reference.clear();
+        edges.clear();
+        fixed.clear();
+        reference_rotate(reference_screen, edge_screen, text, demo_placement(text), degrees);
+        blit_affine(fixed_screen, text, demo_transform(text, fixed_screen, degrees));
+
+        const Difference d = compare(reference_screen, edge_screen, fixed_screen);
+        if (d.holes + d.extra != 0)
+        {
+            failures++;
+            std::printf("MISMATCH: %s %dx%d at %d degrees: %d holes, %d extra\n",
+                        what,
+                        text.width,
+                        text.height,
+                        degrees,
+                        d.holes,
+                        d.extra);
+        }
+    }
+    return failures;
+}
+
+int check_invert()
+{
+    int failures = 0;
+    Affine inverse;
+
+    // 1/65536 and 1/2 px per px: inverses of 65536 (beyond Q16.16) and exactly 2
+    if (Affine::scaling(1, 1).invert(inverse))
+    {
+        failures++;
+        std::printf("MISMATCH: inverse of a 1/65536 scaling accepted\n");
+    }
+    if (!Affine::scaling(to_fixed(1) / 2, to_fixed(1) / 2).invert(inverse) ||
+        inverse.xx != to_fixed(2) || inverse.yy != to_fixed(2))
+    {
+        failures++;
+        std::printf("MISMATCH: inverse of a 1/2 scaling\n");
+    }
+    // The matrix fits, the translation (-51200 px) does not
+    if ((Affine::translation(to_fixed(200), 0) * Affine::scaling(to_fixed(1) / 256, to_fixed(1)))
+            .invert(inverse))
+    {
+        failures++;
+        std::printf("MISMATCH: inverse with an out-of-range translation accepted\n");
+    }
+    return failures;
+}
+
+template <typename Draw>
+double us_per_frame(Draw&& draw)
+{
+    constexpr int kRuns = 5;
+    constexpr int kRounds = 10'000;
+    double best = 0.0;
+    for (int run = 0; run < kRuns; ++run)
+    {
+        const auto start = Clock::now();
+        for (int r = 0; r < kRounds; ++r)
+        {
+            for (int degrees = 0; degrees < 360; degrees += 15)
+            {
+                draw(degrees);
+            }
+        }
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        best = run == 0 ? us : std::min(best, us);
+    }
+    return best / (kRounds * 24.0);
+}
+
+} // namespace
+
+int main()
+{
+    const AtlasFont* font = muc::fonts::find_atlas_font(16);
+    if (!font)
+    {
+        std::printf("no 16 px atlas font\n");
+        return 1;
+    }
+
+    // The text, upright, in a bitmap of exactly its ink
+    muc::fonts::TextLayout layout;
+    muc::fonts::layout_text(*font, "Grüße", 0, layout);
+    const muc::fonts::TextBounds box = layout.bounds();
+    std::vector<std::uint8_t> text_pixels(
+        PageBitmap::bytes(box.right - box.left, box.bottom - box.top));
+    const PageBitmap text{.data = text_pixels.data(),
+                          .width = box.right - box.left,
+                          .height = box.bottom - box.top};
+    muc::fonts::draw_layout(text, *font, layout, -box.left, -box.top);
+
+    NullDevice devices[4];
+    Oled forward(devices[0], kDefaultGeometry);
+    Oled reference(devices[1], kDefaultGeometry);
+    Oled edges(devices[2], kDefaultGeometry);
+    Oled fixed(devices[3], kDefaultGeometry);
+    const PageBitmap reference_screen = muc::fonts::page_bitmap(reference);
+    const PageBitmap edge_screen = muc::fonts::page_bitmap(edges);
+    const PageBitmap fixed_screen = muc::fonts::page_bitmap(fixed);
+    const Placement at = demo_placement(text);
+
+    // Asymmetric, so a wrong turn or mirror shows up too
+    std::uint8_t pattern_pixels[] = {0x1f, 0x01, 0x05, 0x0d, 0x00, 0x11, 0x1f};
+    const PageBitmap pattern{.data = pattern_pixels, .width = 7, .height = 5};
+
+    int failures = check_trig() + check_invert();
+    failures += check_right_angles("text", text);
+    failures += check_right_angles("pattern", pattern);
+    std::printf("text %dx%d px\n\n", text.width, text.height);
+    std::printf("angle   reference px   forward holes/extra   blit_affine holes/extra\n");
+    for (int degrees = 0; degrees < 360; degrees += 15)
+    {
+        forward.clear();
+        reference.clear();
+        edges.clear();
+        fixed.clear();
+        forward_rotate(forward, text, at, degrees);
+        reference_rotate(reference_screen, edge_screen, text, at, degrees);
+        blit_affine(fixed_screen, text, demo_transform(text, fixed_screen, degrees));
+
+        int lit = 0;
+        for (int y = 0; y < reference_screen.height; ++y)
+        {
+            for (int x = 0; x < reference_screen.width; ++x)
+            {
+                lit += reference_screen.pixel(x, y);
+            }
+        }
+        const Difference old =
+            compare(reference_screen, edge_screen, muc::fonts::page_bitmap(forward));
+        const Difference now = compare(reference_screen, edge_screen, fixed_screen);
+        std::printf("%5d   %12d   %11d/%-5d   %17d/%d\n",
+                    degrees,
+                    lit,
+                    old.holes,
+                    old.extra,
+                    now.holes,
+                    now.extra);
+        if (now.unexcused != 0)
+        {
+            failures++;
+            std::printf("MISMATCH: %d pixels away from any source edge\n", now.unexcused);
+        }
+    }
+    std::printf("\nverification: %d failures\n\n", failures);
+
+    const double old_us = us_per_frame([&](int degrees)
+                                       { forward_rotate(forward, text, at, degrees); });
+    const double new_us = us_per_frame(
+        [&](int degrees)
+        { blit_affine(fixed_screen, text, demo_transform(text, fixed_screen, degrees)); });
+    std::printf("us/frame   forward (double)   blit_affine (Q16.16)   speedup\n");
+    std::printf("           %16.2f   %20.2f   %6.1fx\n", old_us, new_us, old_us / new_us);
+
+    return failures == 0 ? 0 : 1;
+}
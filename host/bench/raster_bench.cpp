@@ -0,0 +1,493 @@
+// Glyph rasterization benchmark: the RasterModes FontRenderer can use, at 10 and 16 px.
+//
+//   raster_bench [font.ttf]      (default: the fonts component's TTF)
+//
+// Verifies, per mode and size, that metrics() still reports exactly the box glyph() draws
+// (layouts depend on it), that Threshold mode packs exactly what pack_coverage() did, and
+// that the dither sets half of each 4x4 cell at the configured threshold. Glyphs too large
+// for a cache slot (kOversizedPx) must come out clipped, and leave the other slots alone.
+// Any failure exits non-zero.
+//
+// Then compares, over every glyph of the font:
+//   us/glyph   FT_Load_Char() plus packing, as on a glyph cache miss
+//   ink        set pixels as a share of the ink of the exact outline (unhinted 8-bit
+//              coverage); over 100% means heavier stems
+//   blur RMS   RMS difference to that exact coverage after a 3x3 box blur on both, the
+//              way the eye averages neighbouring pixels (0-255, lower is closer)
+//   lone px    set pixels with no set neighbour (speckle)
+// and prints a sample in every mode.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "FontRenderer.h"
+#include "GlyphRaster.h"
+#include "Utf8.h"
+
+namespace
+{
+
+using muc::fonts::FontRenderer;
+using muc::fonts::kCoverageThreshold;
+using muc::fonts::PackedGlyph;
+using muc::fonts::packed_glyph_bytes;
+using muc::fonts::RasterMode;
+using muc::fonts::RasterOptions;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kSizes[] = {10, 16};
+constexpr const char* kSample = "Grüße 你好";
+// Renders glyphs of the font wider than a glyph cache slot
+constexpr int kOversizedPx = 96;
+
+struct Mode
+{
+    const char* name;
+    RasterOptions options;
+};
+
+constexpr Mode kModes[] = {
+    {"threshold 64", {.mode = RasterMode::Threshold, .threshold = 64}},
+    {"threshold 128", {.mode = RasterMode::Threshold, .threshold = 128}},
+    {"dither 64", {.mode = RasterMode::Dither, .threshold = 64}},
+    {"dither 128", {.mode = RasterMode::Dither, .threshold = 128}},
+    {"mono", {.mode = RasterMode::Mono, .threshold = 0}},
+};
+
+// Glyphs are compared on a canvas with the pen origin at (kOrigin, kOrigin + kCanvas / 2)
+constexpr int kCanvas = 64;
+constexpr int kOrigin = 16;
+
+using Canvas = std::array<int, kCanvas * kCanvas>;
+
+int s_failures = 0;
+
+void fail(const char* what, const char* mode, int pixel_size, std::uint32_t codepoint)
+{
+    if (s_failures++ < 10)
+    {
+        std::printf("MISMATCH: %s, %s at %d px, U+%04X\n", what, mode, pixel_size, codepoint);
+    }
+}
+
+std::vector<std::uint32_t> charmap(FT_Face face)
+{
+    std::vector<std::uint32_t> codepoints;
+    FT_UInt index = 0;
+    for (FT_ULong cp = FT_Get_First_Char(face, &index); index != 0;
+         cp = FT_Get_Next_Char(face, cp, &index))
+    {
+        codepoints.push_back(static_cast<std::uint32_t>(cp));
+    }
+    return codepoints;
+}
+
+// Exact coverage of the unhinted outline
+Canvas outline_coverage(FT_Face face, std::uint32_t codepoint)
+{
+    Canvas canvas{};
+    if (FT_Load_Char(face, codepoint, FT_LOAD_RENDER | FT_LOAD_NO_HINTING))
+    {
+        return canvas;
+    }
+    const FT_GlyphSlot slot = face->glyph;
+    for (unsigned row = 0; row < slot->bitmap.rows; ++row)
+    {
+        for (unsigned col = 0; col < slot->bitmap.width; ++col)
+        {
+            const int x = kOrigin + slot->bitmap_left + static_cast<int>(col);
+            const int y = kOrigin + kCanvas / 2 - slot->bitmap_top + static_cast<int>(row);
+            if (x >= 0 && y >= 0 && x < kCanvas && y < kCanvas)
+            {
+                canvas[y * kCanvas + x] = slot->bitmap.buffer[row * slot->bitmap.pitch + col];
+            }
+        }
+    }
+    return canvas;
+}
+
+Canvas glyph_pixels(const PackedGlyph& glyph)
+{
+    Canvas canvas{};
+    for (int row = 0; row < glyph.rows; ++row)
+    {
+        for (int col = 0; col < glyph.width; ++col)
+        {
+            const int x = kOrigin + glyph.left + col;
+            const int y = kOrigin + kCanvas / 2 - glyph.top + row;
+            if (glyph.pixel(col, row) && x >= 0 && y >= 0 && x < kCanvas && y < kCanvas)
+            {
+                canvas[y * kCanvas + x] = 255;
+            }
+        }
+    }
+    return canvas;
+}
+
+Canvas blur(const Canvas& in)
+{
+    Canvas out{};
+    for (int y = 1; y < kCanvas - 1; ++y)
+    {
+        for (int x = 1; x < kCanvas - 1; ++x)
+        {
+            int sum = 0;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    sum += in[(y + dy) * kCanvas + x + dx];
+                }
+            }
+            out[y * kCanvas + x] = sum / 9;
+        }
+    }
+    return out;
+}
+
+struct Quality
+{
+    double ink = 0.0;      // set pixels * 255
+    double outline = 0.0;  // exact coverage
+    double squared = 0.0;  // blurred difference
+    int lone = 0;
+};
+
+void measure(const Canvas& exact, const Canvas& pixels, Quality& q)
+{
+    const Canvas a = blur(exact);
+    const Canvas b = blur(pixels);
+    for (int y = 1; y < kCanvas - 1; ++y)
+    {
+        for (int x = 1; x < kCanvas - 1; ++x)
+        {
+            const int i = y * kCanvas + x;
+            q.ink += pixels[i];
+            q.outline += exact[i];
+            q.squared += static_cast<double>(a[i] - b[i]) * (a[i] - b[i]);
+
+            bool neighbour = false;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    neighbour |= (dx != 0 || dy != 0) && pixels[i + dy * kCanvas + dx] != 0;
+                }
+            }
+            q.lone += pixels[i] != 0 && !neighbour;
+        }
+    }
+}
+
+double us_per_glyph(FT_Face face,
+                    const std::vector<std::uint32_t>& codepoints,
+                    const RasterOptions& options)
+{
+    constexpr int kRuns = 5;
+    constexpr int kRounds = 2'000;
+    std::vector<std::uint8_t> columns(64 * 1024);
+    double best = 0.0;
+    for (int run = 0; run < kRuns; ++run)
+    {
+        const auto start = Clock::now();
+        for (int r = 0; r < kRounds; ++r)
+        {
+            for (const std::uint32_t cp : codepoints)
+            {
+                if (FT_Load_Char(face, cp, muc::fonts::raster_load_flags(options.mode)) == 0)
+                {
+                    const FT_Bitmap& bitmap = face->glyph->bitmap;
+                    std::fill_n(columns.begin(),
+                                packed_glyph_bytes(static_cast<int>(bitmap.width),
+                                                   static_cast<int>(bitmap.rows)),
+                                0);
+                    muc::fonts::pack_bitmap(bitmap, options, columns.data());
+                }
+            }
+        }
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        best = run == 0 ? us : std::min(best, us);
+    }
+    return best / (static_cast<double>(kRounds) * static_cast<double>(codepoints.size()));
+}
+
+void verify(FontRenderer& font, const std::vector<std::uint32_t>& codepoints)
+{
+    for (const Mode& mode : kModes)
+    {
+        font.set_raster_options(mode.options);
+        for (const std::uint32_t cp : codepoints)
+        {
+            const muc::fonts::GlyphMetrics m = font.metrics(cp);
+            const PackedGlyph* g = font.glyph(cp);
+            if (!g || g->width != m.width || g->rows != m.rows || g->left != m.left ||
+                g->top != m.top || g->advance != m.advance)
+            {
+                fail("metrics() vs. glyph() box", mode.name, font.pixel_size(), cp);
+            }
+        }
+    }
+
+    // Threshold mode packs what the fixed threshold always did
+    for (const std::uint32_t cp : codepoints)
+    {
+        if (FT_Load_Char(font.face, cp, FT_LOAD_RENDER))
+        {
+            continue;
+        }
+        const FT_Bitmap& bitmap = font.face->glyph->bitmap;
+        const int width = static_cast<int>(bitmap.width);
+        const int rows = static_cast<int>(bitmap.rows);
+        std::vector<std::uint8_t> legacy(packed_glyph_bytes(width, rows));
+        std::vector<std::uint8_t> packed(legacy.size());
+        muc::fonts::pack_coverage(
+            bitmap.buffer, bitmap.pitch, width, rows, kCoverageThreshold, legacy.data());
+        muc::fonts::pack_bitmap(bitmap, RasterOptions{}, packed.data());
+        if (legacy != packed)
+        {
+            fail("Threshold vs. pack_coverage()", "threshold 64", font.pixel_size(), cp);
+        }
+    }
+}
+
+void verify_dither()
+{
+    for (int threshold = 0; threshold < 256; ++threshold)
+    {
+        const auto cells = muc::fonts::dither_thresholds(static_cast<std::uint8_t>(threshold));
+        const auto set = std::count_if(
+            cells.begin(), cells.end(), [&](std::uint8_t t) { return threshold > t; });
+        const bool flat = threshold == 0 || threshold == 255;
+        if (set != (flat ? 0 : 8) && s_failures++ < 10)
+        {
+            std::printf("MISMATCH: %d of 16 dither cells lit at threshold %d\n",
+                        static_cast<int>(set),
+                        threshold);
+        }
+    }
+}
+
+// True if the glyph FreeType just rendered has ink in its first page (the rows a clipped
+// slot keeps) to the right of `width`, i.e. where packing it unclipped would overflow
+bool inks_past(const FT_Bitmap& bitmap, int width)
+{
+    for (int row = 0; row < std::min(static_cast<int>(bitmap.rows), 8); ++row)
+    {
+        const std::uint8_t* src = bitmap.buffer + row * bitmap.pitch;
+        for (int col = width; col < static_cast<int>(bitmap.width); ++col)
+        {
+            if (src[col >> 3] & (0x80u >> (col & 7)))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Fills the cache with oversized glyphs (the sample has few codepoints, so at several
+// sizes), then renders one more into the least recently used slot: every other glyph
+// keeps its bytes, and the clipped glyph shows the top-left of the full one
+void verify_oversized(FontRenderer& font, const std::vector<std::uint32_t>& codepoints)
+{
+    font.set_raster_options(RasterOptions{.mode = RasterMode::Mono, .threshold = 0});
+    font.set_pixel_size(kOversizedPx);
+
+    // One whose dropped columns have ink in the kept rows, so an overflow shows
+    const auto load_flags = muc::fonts::raster_load_flags(RasterMode::Mono);
+    const auto slot_width = static_cast<int>(muc::fonts::kGlyphSlotBytes);
+    std::uint32_t wide = 0;
+    for (const std::uint32_t cp : codepoints)
+    {
+        if (!FT_Load_Char(font.face, cp, load_flags) &&
+            inks_past(font.face->glyph->bitmap, slot_width))
+        {
+            wide = cp;
+            break;
+        }
+    }
+    if (wide == 0)
+    {
+        fail("no glyph with ink past a slot", "mono", kOversizedPx, 0);
+        return;
+    }
+
+    struct Cached
+    {
+        std::uint32_t codepoint;
+        const PackedGlyph* glyph;
+        std::vector<std::uint8_t> columns;
+    };
+    std::vector<Cached> cached;
+    for (int size = kOversizedPx + 1; cached.size() < muc::fonts::kGlyphCacheSlots; ++size)
+    {
+        font.set_pixel_size(size);
+        for (const std::uint32_t cp : codepoints)
+        {
+            const PackedGlyph* g =
+                cached.size() < muc::fonts::kGlyphCacheSlots ? font.glyph(cp) : nullptr;
+            if (g)
+            {
+                const std::size_t bytes = packed_glyph_bytes(g->width, g->rows);
+                cached.push_back({cp, g, {g->columns, g->columns + bytes}});
+            }
+        }
+    }
+
+    font.set_pixel_size(kOversizedPx);
+    const PackedGlyph* big = font.glyph(wide);
+    if (!big || packed_glyph_bytes(big->width, big->rows) > muc::fonts::kGlyphSlotBytes)
+    {
+        fail("oversized glyph not clipped to its slot", "mono", kOversizedPx, wide);
+        return;
+    }
+    // The first one was evicted for it
+    for (std::size_t i = 1; i < cached.size(); ++i)
+    {
+        const Cached& c = cached[i];
+        if (!std::equal(c.columns.begin(), c.columns.end(), c.glyph->columns))
+        {
+            fail("cache slot overwritten by an oversized glyph", "mono", kOversizedPx, c.codepoint);
+        }
+    }
+
+    if (FT_Load_Char(font.face, wide, load_flags))
+    {
+        return;
+    }
+    const FT_Bitmap& bitmap = font.face->glyph->bitmap;
+    const int width = static_cast<int>(bitmap.width);
+    const int rows = static_cast<int>(bitmap.rows);
+    std::vector<std::uint8_t> columns(packed_glyph_bytes(width, rows));
+    muc::fonts::pack_bitmap(bitmap, font.raster_options(), columns.data());
+    const PackedGlyph unclipped{.columns = columns.data(),
+                                .width = static_cast<std::uint8_t>(width),
+                                .rows = static_cast<std::uint8_t>(rows),
+                                .left = 0,
+                                .top = 0,
+                                .advance = 0};
+    for (int row = 0; row < big->rows; ++row)
+    {
+        for (int col = 0; col < big->width; ++col)
+        {
+            if (big->pixel(col, row) != unclipped.pixel(col, row))
+            {
+                fail("clipped glyph packed with the wrong stride", "mono", kOversizedPx, wide);
+                return;
+            }
+        }
+    }
+}
+
+// The sample as drawn by glyph(), one text line of '#' and '.'
+void print_sample(FontRenderer& font)
+{
+    const muc::fonts::FontMetrics fm = font.font_metrics();
+    std::vector<std::string> lines(static_cast<std::size_t>(fm.line_height),
+                                   std::string(static_cast<std::size_t>(fm.pixel_size * 8), '.'));
+    int pen = 0;
+    for (const std::uint32_t cp : muc::fonts::Utf8Range(kSample))
+    {
+        const PackedGlyph* g = font.glyph(cp);
+        if (!g)
+        {
+            continue;
+        }
+        for (int row = 0; row < g->rows; ++row)
+        {
+            for (int col = 0; col < g->width; ++col)
+            {
+                const int x = pen + g->left + col;
+                const int y = fm.ascender - g->top + row;
+                if (g->pixel(col, row) && x >= 0 && y >= 0 && y < fm.line_height &&
+                    x < static_cast<int>(lines[0].size()))
+                {
+                    lines[static_cast<std::size_t>(y)][static_cast<std::size_t>(x)] = '#';
+                }
+            }
+        }
+        pen += g->advance;
+    }
+    for (const std::string& line : lines)
+    {
+        std::printf("  %.*s\n", pen, line.c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* path = argc > 1 ? argv[1] : RASTER_BENCH_TTF;
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<std::uint8_t> ttf{std::istreambuf_iterator<char>(file),
+                                        std::istreambuf_iterator<char>()};
+    FontRenderer font;
+    if (ttf.empty() || !font.init(ttf.data(), ttf.size(), kSizes[0]))
+    {
+        std::printf("cannot load %s\n", path);
+        return 1;
+    }
+    const std::vector<std::uint32_t> codepoints = charmap(font.face);
+
+    verify_dither();
+    for (const int size : kSizes)
+    {
+        font.set_pixel_size(size);
+        verify(font, codepoints);
+    }
+    verify_oversized(font, codepoints);
+    std::printf("verification: %d failures\n\n", s_failures);
+
+    std::printf("%zu glyphs\n", codepoints.size());
+    std::printf("size  mode             us/glyph     ink   blur RMS   lone px\n");
+    for (const int size : kSizes)
+    {
+        font.set_pixel_size(size);
+        for (const Mode& mode : kModes)
+        {
+            font.set_raster_options(mode.options);
+            Quality q;
+            for (const std::uint32_t cp : codepoints)
+            {
+                const Canvas exact = outline_coverage(font.face, cp);
+                const PackedGlyph* g = font.glyph(cp);
+                if (g)
+                {
+                    measure(exact, glyph_pixels(*g), q);
+                }
+            }
+            const double pixels = static_cast<double>(codepoints.size()) * (kCanvas - 2) *
+                                  (kCanvas - 2);
+            std::printf("%2d px %-15s %9.2f  %5.0f%%  %9.2f  %8d\n",
+                        size,
+                        mode.name,
+                        us_per_glyph(font.face, codepoints, mode.options),
+                        q.outline > 0 ? 100.0 * q.ink / q.outline : 0.0,
+                        std::sqrt(q.squared / pixels),
+                        q.lone);
+        }
+    }
+
+    for (const int size : kSizes)
+    {
+        font.set_pixel_size(size);
+        for (const Mode& mode : kModes)
+        {
+            font.set_raster_options(mode.options);
+            std::printf("\n%d px, %s\n", size, mode.name);
+            print_sample(font);
+        }
+    }
+
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+// UiQueue backend benchmark: FreeRTOS-style copying queue vs. the lock-free rings.
+//
+// Every run moves UiMessage-sized items (the real UiQueue payload) from producer threads
+// to one consumer that blocks when the queue is empty:
+//   throughput: producers push as fast as they can, the consumer drains
+//   latency:    one producer sends a timestamped message every 50 µs, the consumer
+//               measures enqueue -> dequeue including its wake-up
+//
+// The baseline is the host shim's xQueue (mutex + condition variable, copy in and out),
+// which stands in for the FreeRTOS POSIX port here.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "ring_buffer.h"
+#include "ui_queue.h"
+
+namespace
+{
+
+using muc::ui::MpscRing;
+using muc::ui::NotifyingRing;
+using muc::ui::SpscRing;
+using muc::ui::UiMessage;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kCapacity = 32;
+constexpr std::uint32_t kThroughputItems = 1'000'000;
+constexpr std::uint32_t kLatencyItems = 20'000;
+constexpr auto kLatencyInterval = std::chrono::microseconds(50);
+
+std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch())
+        .count();
+}
+
+// --- Backends with a common send/receive shape --------------------------------
+class QueueBackend
+{
+  public:
+    QueueBackend()
+    : m_handle(xQueueCreate(kCapacity, sizeof(UiMessage)))
+    {
+    }
+
+    ~QueueBackend()
+    {
+        vQueueDelete(m_handle);
+    }
+
+    bool send(const UiMessage& msg)
+    {
+        return xQueueSend(m_handle, &msg, 0) == pdTRUE;
+    }
+
+    bool receive(UiMessage& msg, TickType_t timeout)
+    {
+        return xQueueReceive(m_handle, &msg, timeout) == pdTRUE;
+    }
+
+  private:
+    QueueHandle_t m_handle;
+};
+
+template <typename Ring>
+class RingBackend
+{
+  public:
+    bool send(const UiMessage& msg)
+    {
+        return m_ring.send(msg);
+    }
+
+    bool receive(UiMessage& msg, TickType_t timeout)
+    {
+        return m_ring.receive(msg, timeout);
+    }
+
+  private:
+    NotifyingRing<Ring> m_ring;
+};
+
+using SpscBackend = RingBackend<SpscRing<UiMessage, kCapacity>>;
+using MpscBackend = RingBackend<MpscRing<UiMessage, kCapacity>>;
+
+// --- Runs ---------------------------------------------------------------------
+template <typename Backend>
+double throughput(int producers)
+{
+    Backend backend;
+    const std::uint32_t per_producer = kThroughputItems / static_cast<std::uint32_t>(producers);
+    const std::uint32_t total = per_producer * static_cast<std::uint32_t>(producers);
+
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&backend, per_producer]
+            {
+                UiMessage msg{};
+                msg.type = muc::ui::UiCommandType::SetText;
+                for (std::uint32_t i = 0; i < per_producer; ++i)
+                {
+                    msg.submitted_us = i;
+                    while (!backend.send(msg))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    UiMessage msg{};
+    for (std::uint32_t received = 0; received < total;)
+    {
+        if (backend.receive(msg, portMAX_DELAY))
+        {
+            received++;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    return total / elapsed;
+}
+
+struct Latency
+{
+    std::int64_t p50_ns;
+    std::int64_t p99_ns;
+    std::int64_t max_ns;
+};
+
+template <typename Backend>
+Latency latency()
+{
+    Backend backend;
+    std::vector<std::int64_t> samples;
+    samples.reserve(kLatencyItems);
+
+    std::thread producer(
+        [&backend]
+        {
+            UiMessage msg{};
+            msg.type = muc::ui::UiCommandType::SetText;
+            auto next = Clock::now();
+            for (std::uint32_t i = 0; i < kLatencyItems; ++i)
+            {
+                next += kLatencyInterval;
+                std::this_thread::sleep_until(next);
+                msg.submitted_us = now_ns(); // nanoseconds in this benchmark
+                while (!backend.send(msg))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    UiMessage msg{};
+    while (samples.size() < kLatencyItems)
+    {
+        if (backend.receive(msg, portMAX_DELAY))
+        {
+            samples.push_back(now_ns() - msg.submitted_us);
+        }
+    }
+    producer.join();
+
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back()};
+}
+
+template <typename Backend>
+void report(std::string_view name, int producers)
+{
+    const double rate = throughput<Backend>(producers);
+    std::printf("%-14.*s %9d %14.0f",
+                static_cast<int>(name.size()),
+                name.data(),
+                producers,
+                rate);
+
+    if (producers == 1)
+    {
+        const Latency lat = latency<Backend>();
+        std::printf(" %10.1f %10.1f %10.1f\n",
+                    lat.p50_ns / 1000.0,
+                    lat.p99_ns / 1000.0,
+                    lat.max_ns / 1000.0);
+    }
+    else
+    {
+        std::printf(" %10s %10s %10s\n", "-", "-", "-");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("item size %zu bytes, capacity %zu, %u items per throughput run\n\n",
+                sizeof(UiMessage),
+                kCapacity,
+                kThroughputItems);
+    std::printf("%-14s %9s %14s %10s %10s %10s\n",
+                "backend",
+                "producers",
+                "msgs/s",
+                "p50 us",
+                "p99 us",
+                "max us");
+
+    report<QueueBackend>("xQueue", 1);
+    report<SpscBackend>("SpscRing", 1);
+    report<MpscBackend>("MpscRing", 1);
+    report<QueueBackend>("xQueue", 3);
+    report<MpscBackend>("MpscRing", 3);
+    return 0;
+}
@@ -0,0 +1,313 @@
+// Rotating text benchmark: RotatedTextCache frames vs. blit_affine() of the upright text.
+//
+// Verifies, for "Grüße" at 10 and 16 px, on a 96x96 bitmap so that no angle is clipped:
+//   - at 0/90/180/270 degrees, where rotating the outline and rotating the bitmap are the
+//     same operation, the ink of the FreeType frame is the upright rendering turned by that
+//     angle (wherever it lands: a half-pixel centre rounds either way)
+//   - every cached frame (a hit) reproduces the frame the miss rendered, byte for byte
+//   - afterwards FontRenderer::glyph() renders upright again
+// Any failure exits non-zero.
+//
+// Then, per size and angle step, reports the RAM the cache needs (tight page boxes, and
+// full 360 byte frames for comparison) against the time of a frame: the first, which
+// rasterizes through FreeType, the cached ones, and blit_affine() without a cache.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Affine.h"
+#include "FontRenderer.h"
+#include "II2CDevice.h"
+#include "RotatedTextCache.h"
+#include "TextLayout.h"
+#include "TextRenderer.h"
+#include "ssd1306.h"
+
+namespace
+{
+
+using muc::fonts::Affine;
+using muc::fonts::FontRenderer;
+using muc::fonts::PageBitmap;
+using muc::fonts::RotatedTextCache;
+using muc::fonts::to_fixed;
+using muc::ssd1306::kDefaultGeometry;
+using muc::ssd1306::Oled;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* kText = "Grüße";
+constexpr int kSteps[] = {15, 10, 5, 3};
+constexpr int kSizes[] = {10, 16};
+
+class NullDevice : public muc::II2CDevice
+{
+  public:
+    esp_err_t write(std::span<const std::uint8_t>) noexcept override
+    {
+        return ESP_OK;
+    }
+
+    esp_err_t read(std::span<std::uint8_t>) noexcept override
+    {
+        return ESP_OK;
+    }
+};
+
+// The text drawn upright into a bitmap of exactly its ink, as font_rotate_task does without
+// the cache
+struct UprightText
+{
+    std::vector<std::uint8_t> pixels;
+    PageBitmap bitmap;
+
+    explicit UprightText(FontRenderer& font)
+    {
+        muc::fonts::TextLayout layout;
+        muc::fonts::layout_text(font, kText, 0, layout);
+        const muc::fonts::TextBounds box = layout.bounds();
+        const int width = box.right - box.left;
+        const int height = box.bottom - box.top;
+        pixels.assign(PageBitmap::bytes(width, height), 0);
+        bitmap = PageBitmap{.data = pixels.data(), .width = width, .height = height};
+        muc::fonts::draw_layout(bitmap, font, layout, -box.left, -box.top);
+    }
+
+    void rotate_into(const PageBitmap& screen, int degrees) const
+    {
+        screen.clear();
+        muc::fonts::blit_affine(
+            screen,
+            bitmap,
+            Affine::translation(to_fixed(screen.width) / 2, to_fixed(screen.height) / 2) *
+                Affine::rotation(degrees) *
+                Affine::translation(-to_fixed(bitmap.width) / 2, -to_fixed(bitmap.height) / 2));
+    }
+};
+
+int s_failures = 0;
+
+void fail(const char* what, int pixel_size, int degrees)
+{
+    if (s_failures++ < 10)
+    {
+        std::printf("MISMATCH: %s at %d px, %d degrees\n", what, pixel_size, degrees);
+    }
+}
+
+struct InkBox
+{
+    int left;
+    int top;
+    int width;
+    int height;
+};
+
+InkBox ink_box(const PageBitmap& bitmap)
+{
+    int left = bitmap.width;
+    int top = bitmap.height;
+    int right = 0;
+    int bottom = 0;
+    for (int y = 0; y < bitmap.height; ++y)
+    {
+        for (int x = 0; x < bitmap.width; ++x)
+        {
+            if (bitmap.pixel(x, y))
+            {
+                left = std::min(left, x);
+                top = std::min(top, y);
+                right = std::max(right, x + 1);
+                bottom = std::max(bottom, y + 1);
+            }
+        }
+    }
+    return right > left ? InkBox{left, top, right - left, bottom - top} : InkBox{};
+}
+
+// Whether the ink of `frame` is the ink of `upright` turned clockwise by `degrees`, a
+// multiple of 90
+bool is_turned(const PageBitmap& frame, const PageBitmap& upright, int degrees)
+{
+    const InkBox in = ink_box(upright);
+    const InkBox out = ink_box(frame);
+    const bool sideways = degrees % 180 != 0;
+    if (out.width != (sideways ? in.height : in.width) ||
+        out.height != (sideways ? in.width : in.height))
+    {
+        return false;
+    }
+
+    for (int j = 0; j < out.height; ++j)
+    {
+        for (int i = 0; i < out.width; ++i)
+        {
+            // Upright pixel (u, v) that lands on (i, j) of the turned box
+            int u = i;
+            int v = j;
+            switch (degrees)
+            {
+                case 90:
+                    u = j;
+                    v = in.height - 1 - i;
+                    break;
+                case 180:
+                    u = in.width - 1 - i;
+                    v = in.height - 1 - j;
+                    break;
+                case 270:
+                    u = in.width - 1 - j;
+                    v = i;
+                    break;
+                default:
+                    break;
+            }
+            if (frame.pixel(out.left + i, out.top + j) !=
+                upright.pixel(in.left + u, in.top + v))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void verify(FontRenderer& font)
+{
+    constexpr int kSide = 96;
+    std::vector<std::uint8_t> pixels(PageBitmap::bytes(kSide, kSide));
+    const PageBitmap screen{.data = pixels.data(), .width = kSide, .height = kSide};
+    const UprightText upright(font);
+    std::vector<std::uint8_t> storage(64 * 1024);
+    RotatedTextCache cache(storage);
+    cache.reset(font, kText, 3, screen.width / 2, screen.height / 2);
+
+    std::vector<std::uint8_t> first(PageBitmap::bytes(screen.width, screen.height));
+    for (int degrees = 0; degrees < 360; degrees += 3)
+    {
+        cache.draw(font, screen, degrees);
+        std::memcpy(first.data(), screen.data, first.size());
+        if (degrees % 90 == 0 && !is_turned(screen, upright.bitmap, degrees))
+        {
+            fail("right-angle frame vs. upright text", font.pixel_size(), degrees);
+        }
+
+        std::memset(screen.data, 0xff, first.size());
+        cache.draw(font, screen, degrees);
+        if (std::memcmp(first.data(), screen.data, first.size()) != 0)
+        {
+            fail("cached frame vs. rendered frame", font.pixel_size(), degrees);
+        }
+    }
+
+    // The transform must be gone: an upright glyph keeps its upright box
+    const muc::fonts::GlyphMetrics metrics = font.metrics('G');
+    const muc::fonts::PackedGlyph* glyph = font.glyph('G');
+    if (!glyph || glyph->width != metrics.width || glyph->rows != metrics.rows)
+    {
+        fail("upright glyph after rotation", font.pixel_size(), 0);
+    }
+}
+
+template <typename Draw>
+double us_per_frame(int frames, Draw&& draw)
+{
+    constexpr int kRuns = 5;
+    const int rounds = std::max(1, 200'000 / frames);
+    double best = 0.0;
+    for (int run = 0; run < kRuns; ++run)
+    {
+        const auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                draw(frame);
+            }
+        }
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        best = run == 0 ? us : std::min(best, us);
+    }
+    return best / (static_cast<double>(rounds) * frames);
+}
+
+void report(FontRenderer& font, const PageBitmap& screen)
+{
+    const UprightText upright(font);
+    std::vector<std::uint8_t> storage(64 * 1024);
+    RotatedTextCache cache(storage);
+
+    for (const int step : kSteps)
+    {
+        const int frames = 360 / step;
+
+        // First turn: every frame is a miss
+        cache.reset(font, kText, step, screen.width / 2, screen.height / 2);
+        const auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            cache.draw(font, screen, frame * step);
+        }
+        const double cold =
+            std::chrono::duration<double, std::micro>(Clock::now() - start).count() / frames;
+        const muc::fonts::RotatedTextStats stats = cache.stats();
+
+        const double warm =
+            us_per_frame(frames, [&](int frame) { cache.draw(font, screen, frame * step); });
+        const double blit =
+            us_per_frame(frames, [&](int frame) { upright.rotate_into(screen, frame * step); });
+
+        std::printf("%2d px  %3d deg  %6d  %11zu  %10d  %10.1f  %9.3f  %13.3f\n",
+                    font.pixel_size(),
+                    step,
+                    frames,
+                    stats.bytes_used,
+                    frames * static_cast<int>(PageBitmap::bytes(screen.width, screen.height)),
+                    cold,
+                    warm,
+                    blit);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::ifstream file(ROTATED_TEXT_BENCH_TTF, std::ios::binary);
+    const std::vector<std::uint8_t> ttf{std::istreambuf_iterator<char>(file),
+                                        std::istreambuf_iterator<char>()};
+    FontRenderer font;
+    if (ttf.empty() || !font.init(ttf.data(), ttf.size(), kSizes[0]))
+    {
+        std::printf("cannot load %s\n", ROTATED_TEXT_BENCH_TTF);
+        return 1;
+    }
+
+    NullDevice device;
+    Oled oled(device, kDefaultGeometry);
+    const PageBitmap screen = muc::fonts::page_bitmap(oled);
+
+    for (const int size : kSizes)
+    {
+        font.set_pixel_size(size);
+        verify(font);
+    }
+    std::printf("verification: %d failures\n\n", s_failures);
+
+    std::printf("                        cache bytes              us/frame\n");
+    std::printf("size   step    frames   tight boxes  full frames   first      cached    "
+                "blit_affine\n");
+    for (const int size : kSizes)
+    {
+        font.set_pixel_size(size);
+        report(font, screen);
+    }
+
+    return s_failures == 0 ? 0 : 1;
+}
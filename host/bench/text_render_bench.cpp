@@ -0,0 +1,289 @@
+// Text renderer benchmark: page-major draw_glyph() vs. the drawPixel() path it replaced.
+//
+// First checks that both produce the same framebuffer for every atlas glyph at positions
+// that clip it against each edge, with the baseline at every row offset within a page,
+// on the real 72x40 panel and on a window whose height is not a multiple of 8. Any
+// mismatch exits non-zero.
+//
+// Then times single glyphs of every atlas size at a baseline that straddles two pages,
+// and the font test screen (border, rulers, labels, geometry line at 10 px), once
+// with all text through drawPixel() and once through draw_text(); the non-text parts are
+// identical in both. The bundled TTF is a subset without digits, which would all draw as
+// the blank .notdef glyph, so the labels cycle through the characters it does have.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "FontAtlas.h"
+#include "II2CDevice.h"
+#include "TextRenderer.h"
+#include "ssd1306.h"
+
+namespace
+{
+
+using muc::fonts::AtlasFont;
+using muc::fonts::draw_glyph;
+using muc::fonts::draw_text;
+using muc::fonts::PackedGlyph;
+using muc::fonts::Utf8Range;
+using muc::ssd1306::DisplayGeometry;
+using muc::ssd1306::kDefaultGeometry;
+using muc::ssd1306::Oled;
+
+using Clock = std::chrono::steady_clock;
+
+// The panel is never read back, so transfers can go nowhere
+class NullDevice : public muc::II2CDevice
+{
+  public:
+    esp_err_t write(std::span<const std::uint8_t>) noexcept override
+    {
+        return ESP_OK;
+    }
+
+    esp_err_t read(std::span<std::uint8_t>) noexcept override
+    {
+        return ESP_OK;
+    }
+};
+
+// --- Previous renderer --------------------------------------------------------
+void pixel_draw_glyph(Oled& oled, const PackedGlyph& glyph, int x, int y)
+{
+    const int left = x + glyph.left;
+    const int top = y - glyph.top;
+    for (int page = 0; page < glyph.pages(); ++page)
+    {
+        const std::uint8_t* columns = glyph.columns + page * glyph.width;
+        for (int col = 0; col < glyph.width; ++col)
+        {
+            for (std::uint8_t bits = columns[col]; bits != 0; bits &= bits - 1)
+            {
+                const int row = page * 8 + __builtin_ctz(bits);
+                oled.drawPixel(left + col, top + row, true);
+            }
+        }
+    }
+}
+
+int pixel_draw_text(Oled& oled, const AtlasFont& font, int x, int y, std::string_view text)
+{
+    std::uint32_t previous = 0;
+    for (std::uint32_t codepoint : Utf8Range(text))
+    {
+        const PackedGlyph* glyph = font.glyph(codepoint);
+        x += previous ? font.kerning(previous, codepoint) : 0;
+        pixel_draw_glyph(oled, *glyph, x, y);
+        x += glyph->advance;
+        previous = codepoint;
+    }
+    return x;
+}
+
+// --- Verification -------------------------------------------------------------
+std::uint64_t s_checked = 0;
+std::uint64_t s_failures = 0;
+
+void check_glyph(Oled& expected, Oled& actual, const PackedGlyph& glyph, int x, int y)
+{
+    expected.clear();
+    actual.clear();
+    pixel_draw_glyph(expected, glyph, x, y);
+    draw_glyph(actual, glyph, x, y);
+
+    s_checked++;
+    const auto want = expected.framebuffer();
+    const auto got = actual.framebuffer();
+    if (std::memcmp(want.data(), got.data(), want.size()) != 0 && s_failures++ < 10)
+    {
+        std::printf("MISMATCH: %dx%d glyph at (%d, %d) on a %dx%d window\n",
+                    glyph.width,
+                    glyph.rows,
+                    x,
+                    y,
+                    expected.geometry().width,
+                    expected.geometry().height);
+    }
+}
+
+void check_geometry(const DisplayGeometry& geometry, const AtlasFont& font)
+{
+    NullDevice device_a;
+    NullDevice device_b;
+    Oled expected(device_a, geometry);
+    Oled actual(device_b, geometry);
+
+    std::vector<const PackedGlyph*> glyphs;
+    for (const PackedGlyph& glyph : font.glyphs)
+    {
+        glyphs.push_back(&glyph);
+    }
+    glyphs.push_back(&font.fallback);
+
+    for (const PackedGlyph* glyph : glyphs)
+    {
+        for (int y = -font.pixel_size; y < geometry.height + font.pixel_size; ++y)
+        {
+            for (int x = -font.pixel_size; x < geometry.width + 2; x += 3)
+            {
+                check_glyph(expected, actual, *glyph, x, y);
+            }
+        }
+    }
+}
+
+// --- Benchmark ----------------------------------------------------------------
+template <typename DrawText>
+void draw_test_screen(Oled& oled, DrawText&& text)
+{
+    const DisplayGeometry& geom = oled.geometry();
+    oled.clear();
+
+    for (int x = 0; x < geom.width; ++x)
+    {
+        oled.drawPixel(x, 0, true);
+        oled.drawPixel(x, geom.height - 1, true);
+    }
+    for (int y = 0; y < geom.height; ++y)
+    {
+        oled.drawPixel(0, y, true);
+        oled.drawPixel(geom.width - 1, y, true);
+    }
+
+    // Two-character labels in place of the ruler numbers
+    constexpr std::string_view kLabels[] = {"Gr", "üß", "e你", "好G", "re", "ßü", "你好"};
+    std::size_t label = 0;
+
+    for (int x = 0; x < geom.width; x += 4)
+    {
+        oled.drawPixel(x, 10, true);
+    }
+    for (int x = 0; x < geom.width; x += 8)
+    {
+        text(x, 20, kLabels[label++ % std::size(kLabels)]);
+    }
+
+    for (int y = 0; y < geom.height; y += 4)
+    {
+        oled.drawPixel(10, y, true);
+    }
+    for (int y = 0; y < geom.height; y += 8)
+    {
+        text(12, y + 8, kLabels[label++ % std::size(kLabels)]);
+    }
+
+    text(2, geom.height - 2, "Grüße 你好 Grüße");
+}
+
+template <typename DrawText>
+double us_per_screen(Oled& oled, DrawText&& text)
+{
+    constexpr int kRounds = 100'000;
+    const auto start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+    {
+        draw_test_screen(oled, text);
+    }
+    const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return us / kRounds;
+}
+
+// Average over all glyphs of `font`, drawn where every page straddles two screen pages
+template <typename DrawGlyph>
+double ns_per_glyph(Oled& oled, const AtlasFont& font, DrawGlyph&& draw)
+{
+    constexpr int kRounds = 200'000;
+    const auto start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+    {
+        for (const PackedGlyph& glyph : font.glyphs)
+        {
+            draw(oled, glyph, 20, 21);
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / (static_cast<double>(kRounds) * static_cast<double>(font.glyphs.size()));
+}
+
+} // namespace
+
+int main()
+{
+    const AtlasFont* font = muc::fonts::find_atlas_font(10);
+    if (!font)
+    {
+        std::printf("no 10 px atlas font\n");
+        return 1;
+    }
+
+    DisplayGeometry odd = kDefaultGeometry;
+    odd.height = 36;
+    check_geometry(kDefaultGeometry, *font);
+    check_geometry(odd, *font);
+
+    NullDevice device_a;
+    NullDevice device_b;
+    Oled by_pixel(device_a, kDefaultGeometry);
+    Oled by_page(device_b, kDefaultGeometry);
+    const auto pixel_text = [&](int x, int y, std::string_view s)
+    { pixel_draw_text(by_pixel, *font, x, y, s); };
+    const auto page_text = [&](int x, int y, std::string_view s)
+    { draw_text(by_page, *font, x, y, s); };
+
+    draw_test_screen(by_pixel, pixel_text);
+    draw_test_screen(by_page, page_text);
+    s_checked++;
+    if (std::memcmp(by_pixel.framebuffer().data(),
+                    by_page.framebuffer().data(),
+                    by_page.framebuffer().size()) != 0)
+    {
+        s_failures++;
+        std::printf("MISMATCH: font test screen\n");
+    }
+    std::printf("verification: %llu cases, %llu failures\n\n",
+                static_cast<unsigned long long>(s_checked),
+                static_cast<unsigned long long>(s_failures));
+
+    std::printf("ns/glyph   set px   drawPixel()   draw_glyph()   speedup\n");
+    for (const AtlasFont* size : muc::fonts::atlas_fonts())
+    {
+        int set = 0;
+        for (const PackedGlyph& glyph : size->glyphs)
+        {
+            for (int row = 0; row < glyph.rows; ++row)
+            {
+                for (int col = 0; col < glyph.width; ++col)
+                {
+                    set += glyph.pixel(col, row) ? 1 : 0;
+                }
+            }
+        }
+        const double pixel = ns_per_glyph(by_pixel, *size, pixel_draw_glyph);
+        const double page = ns_per_glyph(by_page,
+                                         *size,
+                                         [](Oled& oled, const PackedGlyph& glyph, int x, int y)
+                                         { draw_glyph(oled, glyph, x, y); });
+        std::printf("%2d px    %7.1f   %11.1f   %12.1f   %6.1fx\n",
+                    size->pixel_size,
+                    static_cast<double>(set) / static_cast<double>(size->glyphs.size()),
+                    pixel,
+                    page,
+                    pixel / page);
+    }
+    std::printf("\n");
+
+    const double empty = us_per_screen(by_page, [](int, int, std::string_view) {});
+    const double pixel = us_per_screen(by_pixel, pixel_text);
+    const double page = us_per_screen(by_page, page_text);
+    std::printf("font test screen, us/frame   total    text only\n");
+    std::printf("drawPixel()                %7.3f  %7.3f\n", pixel, pixel - empty);
+    std::printf("page-major draw_glyph()    %7.3f  %7.3f\n", page, page - empty);
+    std::printf("text speedup                        %6.1fx\n", (pixel - empty) / (page - empty));
+
+    return s_failures == 0 ? 0 : 1;
+}
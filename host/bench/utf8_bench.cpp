@@ -0,0 +1,349 @@
+// UTF-8 decoder check and benchmark.
+//
+// First verifies the fonts component's decoder exhaustively against a reference built
+// from the encoder side: every 1-, 2- and 3-byte input and every 4-byte input with a
+// 0xF0..0xF7 lead must decode to the code point whose encoding it is, or to U+FFFD
+// while consuming exactly the maximal subpart (the longest prefix of any valid
+// encoding, at least one byte). Random strings then cross-check decode_utf8(),
+// Utf8Range, the bulk decoder and utf8_length(). Any mismatch exits non-zero.
+//
+// Then times the decoders on ASCII, German and CJK text against the previous
+// unvalidated decode_utf8(const char*&).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Utf8.h"
+
+namespace
+{
+
+using muc::fonts::decode_utf8;
+using muc::fonts::kReplacementChar;
+using muc::fonts::utf8_length;
+using muc::fonts::Utf8Range;
+
+using Clock = std::chrono::steady_clock;
+
+// --- Reference ----------------------------------------------------------------
+std::string encode(std::uint32_t cp)
+{
+    std::string out;
+    if (cp < 0x80)
+    {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+// Prefixes of all valid encodings (the encodings of every scalar value), by length:
+// prefix[k][bytes] is set if the first k+1 bytes start some encoding, complete[k] if
+// they are one. Four-byte encodings are exactly a 3-byte prefix plus any continuation.
+struct Reference
+{
+    std::vector<bool> prefix[3];
+    std::vector<bool> complete[3];
+    std::vector<std::uint32_t> value[3];
+
+    Reference()
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            prefix[k].assign(std::size_t{1} << (8 * (k + 1)), false);
+            complete[k].assign(std::size_t{1} << (8 * (k + 1)), false);
+            value[k].assign(std::size_t{1} << (8 * (k + 1)), 0);
+        }
+
+        for (std::uint32_t cp = 0; cp <= 0x10FFFF; ++cp)
+        {
+            if (cp >= 0xD800 && cp <= 0xDFFF)
+            {
+                continue;
+            }
+            const std::string bytes = encode(cp);
+            std::uint32_t key = 0;
+            for (std::size_t k = 0; k < bytes.size() && k < 3; ++k)
+            {
+                key = (key << 8) | static_cast<std::uint8_t>(bytes[k]);
+                prefix[k][key] = true;
+                if (k + 1 == bytes.size())
+                {
+                    complete[k][key] = true;
+                    value[k][key] = cp;
+                }
+            }
+        }
+    }
+
+    // Expected code point and byte count for decoding `s`
+    void expect(std::string_view s, std::uint32_t& cp, std::size_t& used) const
+    {
+        std::uint32_t key = 0;
+        std::size_t k = 0;
+        for (; k < s.size() && k < 3; ++k)
+        {
+            const std::uint32_t next = (key << 8) | static_cast<std::uint8_t>(s[k]);
+            if (!prefix[k][next])
+            {
+                break;
+            }
+            key = next;
+            if (complete[k][key])
+            {
+                cp = value[k][key];
+                used = k + 1;
+                return;
+            }
+        }
+
+        // A valid 3-byte prefix only continues into 4-byte encodings
+        const auto last = static_cast<std::uint8_t>(s.size() >= 4 ? s[3] : 0);
+        if (k == 3 && (last & 0xC0) == 0x80)
+        {
+            cp = ((key >> 16 & 0x07) << 18) | ((key >> 8 & 0x3F) << 12) | ((key & 0x3F) << 6) |
+                 (last & 0x3F);
+            used = 4;
+            return;
+        }
+
+        cp = kReplacementChar;
+        used = k > 0 ? k : 1;
+    }
+};
+
+std::uint64_t s_checked = 0;
+std::uint64_t s_failures = 0;
+
+void check(const Reference& ref, std::string_view s)
+{
+    std::uint32_t want_cp = 0;
+    std::size_t want_used = 0;
+    ref.expect(s, want_cp, want_used);
+
+    std::string_view rest = s;
+    const std::uint32_t cp = decode_utf8(rest);
+    const std::size_t used = s.size() - rest.size();
+
+    s_checked++;
+    if (cp != want_cp || used != want_used)
+    {
+        if (s_failures++ < 10)
+        {
+            std::printf("MISMATCH:");
+            for (char c : s)
+            {
+                std::printf(" %02X", static_cast<std::uint8_t>(c));
+            }
+            std::printf(" -> U+%04X/%zu, expected U+%04X/%zu\n", cp, used, want_cp, want_used);
+        }
+    }
+}
+
+void check_exhaustive(const Reference& ref)
+{
+    char buf[4];
+    for (std::uint32_t a = 0; a < 256; ++a)
+    {
+        buf[0] = static_cast<char>(a);
+        check(ref, std::string_view(buf, 1));
+        for (std::uint32_t b = 0; b < 256; ++b)
+        {
+            buf[1] = static_cast<char>(b);
+            check(ref, std::string_view(buf, 2));
+            for (std::uint32_t c = 0; c < 256; ++c)
+            {
+                buf[2] = static_cast<char>(c);
+                check(ref, std::string_view(buf, 3));
+                if (a < 0xF0 || a > 0xF7)
+                {
+                    continue;
+                }
+                for (std::uint32_t d = 0; d < 256; ++d)
+                {
+                    buf[3] = static_cast<char>(d);
+                    check(ref, std::string_view(buf, 4));
+                }
+            }
+        }
+    }
+}
+
+// Random strings mixing valid text and junk: every decoding interface must agree
+void check_interfaces(std::mt19937& rng)
+{
+    const std::string pieces[] = {"a", "Z ", "ü", "ß", "€", "你", "😀", "\x80", "\xC3", "\xE2\x82",
+                                  "\xF0\x9F\x98", "\xED\xA0\x80", "\xC0\xAF", "\xF4\x90\x80\x80"};
+    std::vector<std::uint32_t> bulk(512);
+    for (int round = 0; round < 200'000; ++round)
+    {
+        std::string text;
+        const int count = static_cast<int>(rng() % 40);
+        for (int i = 0; i < count; ++i)
+        {
+            text += (rng() % 3) ? "plain ascii run " : pieces[rng() % std::size(pieces)];
+        }
+
+        std::vector<std::uint32_t> expected;
+        for (std::string_view rest = text; !rest.empty();)
+        {
+            expected.push_back(decode_utf8(rest));
+        }
+
+        std::vector<std::uint32_t> iterated;
+        for (std::uint32_t cp : Utf8Range(text))
+        {
+            iterated.push_back(cp);
+        }
+
+        const std::size_t decoded = decode_utf8(text, bulk);
+        const bool bulk_ok = decoded == std::min(expected.size(), bulk.size()) &&
+                             std::equal(bulk.begin(), bulk.begin() + decoded, expected.begin());
+
+        s_checked++;
+        if (iterated != expected || !bulk_ok || utf8_length(text) != expected.size())
+        {
+            if (s_failures++ < 10)
+            {
+                std::printf("MISMATCH between interfaces on a %zu byte string\n", text.size());
+            }
+        }
+    }
+}
+
+// --- Benchmark ----------------------------------------------------------------
+// The decoder this replaces: no bounds, no validation, 4-byte sequences become '?'
+std::uint32_t legacy_decode_utf8(const char*& p)
+{
+    std::uint8_t c = static_cast<std::uint8_t>(*p++);
+    if (c < 0x80)
+    {
+        return c;
+    }
+    if ((c & 0xE0) == 0xC0)
+    {
+        return ((c & 0x1F) << 6) | (static_cast<std::uint8_t>(*p++) & 0x3F);
+    }
+    if ((c & 0xF0) == 0xE0)
+    {
+        std::uint8_t c2 = static_cast<std::uint8_t>(*p++);
+        std::uint8_t c3 = static_cast<std::uint8_t>(*p++);
+        return ((c & 0x0F) << 12) | ((c2 & 0x3F) << 6) | (c3 & 0x3F);
+    }
+    return '?';
+}
+
+template <typename Fn>
+double ns_per_byte(const std::string& text, Fn&& fn)
+{
+    constexpr int kRounds = 2000;
+    volatile std::uint32_t sink = 0;
+    const auto start = Clock::now();
+    for (int r = 0; r < kRounds; ++r)
+    {
+        sink = sink + fn(text);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / (static_cast<double>(kRounds) * static_cast<double>(text.size()));
+}
+
+void bench(const char* name, std::string_view sample)
+{
+    std::string text;
+    while (text.size() < 16 * 1024)
+    {
+        text += sample;
+    }
+
+    const double legacy = ns_per_byte(text,
+                                      [](const std::string& t)
+                                      {
+                                          std::uint32_t sum = 0;
+                                          for (const char* p = t.c_str(); *p;)
+                                          {
+                                              sum += legacy_decode_utf8(p);
+                                          }
+                                          return sum;
+                                      });
+    const double single = ns_per_byte(text,
+                                      [](const std::string& t)
+                                      {
+                                          std::uint32_t sum = 0;
+                                          for (std::string_view rest = t; !rest.empty();)
+                                          {
+                                              sum += decode_utf8(rest);
+                                          }
+                                          return sum;
+                                      });
+    const double range = ns_per_byte(text,
+                                     [](const std::string& t)
+                                     {
+                                         std::uint32_t sum = 0;
+                                         for (std::uint32_t cp : Utf8Range(t))
+                                         {
+                                             sum += cp;
+                                         }
+                                         return sum;
+                                     });
+    static std::vector<std::uint32_t> out(16 * 1024);
+    const double bulk = ns_per_byte(text,
+                                    [](const std::string& t)
+                                    { return static_cast<std::uint32_t>(decode_utf8(t, out)); });
+    const double length = ns_per_byte(
+        text, [](const std::string& t) { return static_cast<std::uint32_t>(utf8_length(t)); });
+
+    std::printf("%-8s %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                name,
+                legacy,
+                single,
+                range,
+                bulk,
+                length);
+}
+
+} // namespace
+
+int main()
+{
+    const Reference ref;
+    check_exhaustive(ref);
+    std::mt19937 rng(42);
+    check_interfaces(rng);
+    std::printf("verification: %llu cases, %llu failures\n\n",
+                static_cast<unsigned long long>(s_checked),
+                static_cast<unsigned long long>(s_failures));
+
+    std::printf("ns/byte  %10s %10s %10s %10s %10s\n",
+                "legacy",
+                "decode",
+                "Utf8Range",
+                "bulk",
+                "length");
+    bench("ascii", "X=28 Y=24 W=72 H=40 192.168.100.200 RSSI -67 dBm ");
+    bench("german", "Grüße aus Köln, schöne Straße, Übermaß an Äpfeln. ");
+    bench("cjk", "你好世界，欢迎使用显示屏。");
+
+    return s_failures == 0 ? 0 : 1;
+}
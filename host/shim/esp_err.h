@@ -0,0 +1,11 @@
+#ifndef HOST_SHIM_ESP_ERR_H
+#define HOST_SHIM_ESP_ERR_H
+
+using esp_err_t = int;
+
+constexpr esp_err_t ESP_OK = 0;
+constexpr esp_err_t ESP_FAIL = -1;
+
+const char* esp_err_to_name(esp_err_t err);
+
+#endif // HOST_SHIM_ESP_ERR_H
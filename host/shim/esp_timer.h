@@ -0,0 +1,9 @@
+#ifndef HOST_SHIM_ESP_TIMER_H
+#define HOST_SHIM_ESP_TIMER_H
+
+#include <cstdint>
+
+// Monotonic microseconds since process start
+std::int64_t esp_timer_get_time();
+
+#endif // HOST_SHIM_ESP_TIMER_H
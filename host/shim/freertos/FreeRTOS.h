@@ -0,0 +1,38 @@
+#ifndef HOST_SHIM_FREERTOS_H
+#define HOST_SHIM_FREERTOS_H
+
+// Minimal FreeRTOS surface used by the firmware components, backed by the C++
+// standard library (see shim.cpp). One tick is one millisecond.
+
+#include <cstddef>
+#include <cstdint>
+
+using TickType_t = std::uint32_t;
+using BaseType_t = long;
+using UBaseType_t = unsigned long;
+using StackType_t = std::uint32_t;
+using TaskHandle_t = void*;
+using QueueHandle_t = struct HostQueue*;
+
+constexpr BaseType_t pdTRUE = 1;
+constexpr BaseType_t pdFALSE = 0;
+constexpr BaseType_t pdPASS = pdTRUE;
+constexpr TickType_t portMAX_DELAY = 0xFFFFFFFFU;
+constexpr TickType_t portTICK_PERIOD_MS = 1;
+
+// Same as the firmware's sdkconfig (index 1 is UiLock's)
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+#define configASSERT(x)                                                                            \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(x))                                                                                  \
+        {                                                                                          \
+            host_shim_assert_failed(#x, __FILE__, __LINE__);                                       \
+        }                                                                                          \
+    } while (0)
+
+[[noreturn]] void host_shim_assert_failed(const char* expr, const char* file, int line);
+
+#endif // HOST_SHIM_FREERTOS_H
@@ -0,0 +1,14 @@
+#ifndef HOST_SHIM_FREERTOS_QUEUE_H
+#define HOST_SHIM_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+// Copying bounded queue with FreeRTOS semantics (item copied in and out)
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t wait);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#endif // HOST_SHIM_FREERTOS_QUEUE_H
@@ -0,0 +1,31 @@
+#ifndef HOST_SHIM_FREERTOS_RINGBUF_H
+#define HOST_SHIM_FREERTOS_RINGBUF_H
+
+#include <cstddef>
+
+#include "freertos/FreeRTOS.h"
+
+// ESP-IDF ring buffer, no-split type only. Items are accounted like the real one
+// (8-byte header, size rounded up to 4) so the same capacity fills up at the same point.
+using RingbufHandle_t = struct HostRingbuf*;
+
+enum RingbufferType_t
+{
+    RINGBUF_TYPE_NOSPLIT = 0
+};
+
+RingbufHandle_t xRingbufferCreate(std::size_t size, RingbufferType_t type);
+void vRingbufferDelete(RingbufHandle_t ringbuf);
+BaseType_t xRingbufferSendAcquire(RingbufHandle_t ringbuf,
+                                  void** item,
+                                  std::size_t size,
+                                  TickType_t wait);
+BaseType_t xRingbufferSendComplete(RingbufHandle_t ringbuf, void* item);
+void* xRingbufferReceive(RingbufHandle_t ringbuf, std::size_t* size, TickType_t wait);
+void vRingbufferReturnItem(RingbufHandle_t ringbuf, void* item);
+BaseType_t xRingbufferSendFromISR(RingbufHandle_t ringbuf,
+                                  const void* data,
+                                  std::size_t size,
+                                  BaseType_t* woken);
+
+#endif // HOST_SHIM_FREERTOS_RINGBUF_H
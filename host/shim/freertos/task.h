@@ -0,0 +1,32 @@
+#ifndef HOST_SHIM_FREERTOS_TASK_H
+#define HOST_SHIM_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+using TaskFunction_t = void (*)(void*);
+
+// Tasks run on detached std::threads; the host runner normally drives the UI
+// synchronously and never creates any.
+BaseType_t xTaskCreate(TaskFunction_t fn,
+                       const char* name,
+                       std::uint32_t stack_depth,
+                       void* arg,
+                       UBaseType_t priority,
+                       TaskHandle_t* handle);
+void vTaskDelete(TaskHandle_t handle);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+
+// Direct-to-task notifications; the plain calls use index 0. Every thread gets a handle
+// on first use.
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index);
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t* woken);
+std::uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index,
+                                      BaseType_t clear_on_exit,
+                                      TickType_t wait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken);
+std::uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t wait);
+
+#endif // HOST_SHIM_FREERTOS_TASK_H
@@ -0,0 +1,15 @@
+#ifndef HOST_SHIM_SDKCONFIG_H
+#define HOST_SHIM_SDKCONFIG_H
+
+// No menuconfig on the host: Kconfig defaults of the options the UI and fonts components read
+#define CONFIG_UI_UPDATE_MODE_QUEUE 1
+// The runner is also built per UiQueue backend, which then comes as a compile definition
+#if !CONFIG_UI_QUEUE_BACKEND_RING && !CONFIG_UI_QUEUE_BACKEND_FREERTOS
+#define CONFIG_UI_QUEUE_BACKEND_STREAM 1
+#endif
+#define CONFIG_UI_QUEUE_STREAM_BYTES 512
+#define CONFIG_UI_MAX_MESSAGES_PER_PASS 16
+#define CONFIG_FONTS_FREETYPE_ARENA_BYTES 40960
+#define CONFIG_FONTS_RASTER_MONO 1
+
+#endif // HOST_SHIM_SDKCONFIG_H
@@ -0,0 +1,366 @@
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/ringbuf.h"
+#include "freertos/task.h"
+
+namespace
+{
+const auto s_start = std::chrono::steady_clock::now();
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Diagnostics
+// -----------------------------------------------------------------------------
+void host_shim_assert_failed(const char* expr, const char* file, int line)
+{
+    std::fprintf(stderr, "configASSERT(%s) failed at %s:%d\n", expr, file, line);
+    std::abort();
+}
+
+const char* esp_err_to_name(esp_err_t err)
+{
+    return err == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
+
+std::int64_t esp_timer_get_time()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                 s_start)
+        .count();
+}
+
+// -----------------------------------------------------------------------------
+// Tasks
+// -----------------------------------------------------------------------------
+BaseType_t xTaskCreate(TaskFunction_t fn,
+                       const char*,
+                       std::uint32_t,
+                       void* arg,
+                       UBaseType_t,
+                       TaskHandle_t* handle)
+{
+    std::thread(fn, arg).detach();
+    if (handle)
+    {
+        *handle = nullptr;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t)
+{
+    // Only ever used as vTaskDelete(nullptr) at the end of a task body
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return static_cast<TickType_t>(esp_timer_get_time() / 1000);
+}
+
+// -----------------------------------------------------------------------------
+// Task notifications
+// -----------------------------------------------------------------------------
+namespace
+{
+struct HostTask
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::array<std::uint32_t, configTASK_NOTIFICATION_ARRAY_ENTRIES> value{};
+};
+
+thread_local HostTask s_this_task;
+} // namespace
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return &s_this_task;
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index)
+{
+    auto* t = static_cast<HostTask*>(task);
+    configASSERT(index < t->value.size());
+    {
+        std::lock_guard<std::mutex> lock(t->mutex);
+        t->value[index]++;
+    }
+    // Waiters on other indices re-check their own value and keep waiting
+    t->cv.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t* woken)
+{
+    xTaskNotifyGiveIndexed(task, index);
+    if (woken)
+    {
+        *woken = pdTRUE;
+    }
+}
+
+std::uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index,
+                                      BaseType_t clear_on_exit,
+                                      TickType_t wait)
+{
+    HostTask& t = s_this_task;
+    configASSERT(index < t.value.size());
+    std::uint32_t& slot = t.value[index];
+    std::unique_lock<std::mutex> lock(t.mutex);
+    if (wait == portMAX_DELAY)
+    {
+        t.cv.wait(lock, [&] { return slot > 0; });
+    }
+    else
+    {
+        t.cv.wait_for(lock, std::chrono::milliseconds(wait), [&] { return slot > 0; });
+    }
+
+    const std::uint32_t value = slot;
+    if (value > 0)
+    {
+        slot = clear_on_exit ? 0 : value - 1;
+    }
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    return xTaskNotifyGiveIndexed(task, 0);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken)
+{
+    vTaskNotifyGiveIndexedFromISR(task, 0, woken);
+}
+
+std::uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t wait)
+{
+    return ulTaskNotifyTakeIndexed(0, clear_on_exit, wait);
+}
+
+// -----------------------------------------------------------------------------
+// Queues
+// -----------------------------------------------------------------------------
+struct HostQueue
+{
+    std::size_t length;
+    std::size_t item_size;
+    std::deque<std::vector<std::uint8_t>> items;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+};
+
+namespace
+{
+template <typename Pred>
+bool wait_for(std::condition_variable& cv,
+              std::unique_lock<std::mutex>& lock,
+              TickType_t wait,
+              Pred pred)
+{
+    if (wait == portMAX_DELAY)
+    {
+        cv.wait(lock, pred);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(wait), pred);
+}
+} // namespace
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    auto* q = new HostQueue{};
+    q->length = length;
+    q->item_size = item_size;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t wait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_for(queue->not_full, lock, wait, [&] { return queue->items.size() < queue->length; }))
+    {
+        return pdFALSE;
+    }
+
+    const auto* bytes = static_cast<const std::uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + queue->item_size);
+    queue->not_empty.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken)
+{
+    if (woken)
+    {
+        *woken = pdTRUE;
+    }
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_for(queue->not_empty, lock, wait, [&] { return !queue->items.empty(); }))
+    {
+        return pdFALSE;
+    }
+
+    std::memcpy(item, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    queue->not_full.notify_one();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->items.size();
+}
+
+// -----------------------------------------------------------------------------
+// Ring buffers (no-split)
+// -----------------------------------------------------------------------------
+struct HostRingbuf
+{
+    struct Item
+    {
+        std::vector<std::uint8_t> bytes;
+        bool complete = false;
+    };
+
+    std::size_t capacity;
+    std::size_t used = 0;
+    std::list<Item> items; // stable addresses while an item is acquired or received
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+namespace
+{
+std::size_t accounted_size(std::size_t size)
+{
+    return 8 + ((size + 3) & ~std::size_t{3});
+}
+} // namespace
+
+RingbufHandle_t xRingbufferCreate(std::size_t size, RingbufferType_t)
+{
+    auto* rb = new HostRingbuf{};
+    rb->capacity = size;
+    return rb;
+}
+
+void vRingbufferDelete(RingbufHandle_t ringbuf)
+{
+    delete ringbuf;
+}
+
+BaseType_t xRingbufferSendAcquire(RingbufHandle_t rb,
+                                  void** item,
+                                  std::size_t size,
+                                  TickType_t wait)
+{
+    std::unique_lock<std::mutex> lock(rb->mutex);
+    const std::size_t need = accounted_size(size);
+    if (!wait_for(rb->changed, lock, wait, [&] { return rb->used + need <= rb->capacity; }))
+    {
+        return pdFALSE;
+    }
+
+    rb->used += need;
+    rb->items.push_back({std::vector<std::uint8_t>(size), false});
+    *item = rb->items.back().bytes.data();
+    return pdTRUE;
+}
+
+BaseType_t xRingbufferSendComplete(RingbufHandle_t rb, void* item)
+{
+    std::lock_guard<std::mutex> lock(rb->mutex);
+    for (auto& it : rb->items)
+    {
+        if (it.bytes.data() == item)
+        {
+            it.complete = true;
+        }
+    }
+    rb->changed.notify_all();
+    return pdTRUE;
+}
+
+void* xRingbufferReceive(RingbufHandle_t rb, std::size_t* size, TickType_t wait)
+{
+    std::unique_lock<std::mutex> lock(rb->mutex);
+    // Items are handed out in acquire order, so an incomplete head blocks the rest
+    const auto ready = [&] { return !rb->items.empty() && rb->items.front().complete; };
+    if (!wait_for(rb->changed, lock, wait, ready))
+    {
+        return nullptr;
+    }
+
+    auto& front = rb->items.front();
+    front.complete = false; // now owned by the reader until returned
+    *size = front.bytes.size();
+    return front.bytes.data();
+}
+
+void vRingbufferReturnItem(RingbufHandle_t rb, void* item)
+{
+    std::lock_guard<std::mutex> lock(rb->mutex);
+    for (auto it = rb->items.begin(); it != rb->items.end(); ++it)
+    {
+        if (it->bytes.data() == item)
+        {
+            rb->used -= accounted_size(it->bytes.size());
+            rb->items.erase(it);
+            break;
+        }
+    }
+    rb->changed.notify_all();
+}
+
+// No interrupts on the host: the FromISR variants are the non-blocking task calls
+BaseType_t xRingbufferSendFromISR(RingbufHandle_t rb,
+                                  const void* data,
+                                  std::size_t size,
+                                  BaseType_t* woken)
+{
+    void* item = nullptr;
+    if (xRingbufferSendAcquire(rb, &item, size, 0) != pdTRUE)
+    {
+        return pdFALSE;
+    }
+    std::memcpy(item, data, size);
+    if (woken)
+    {
+        *woken = pdTRUE;
+    }
+    return xRingbufferSendComplete(rb, item);
+}
@@ -0,0 +1,10 @@
+// The firmware embeds the TTF through the fonts component's EMBED_FILES, which brackets its
+// bytes with these two symbols; the host runner links the same file under the same names.
+// UI_HOST_TTF is its path (see CMakeLists.txt).
+asm(".section .rodata\n"
+    ".global _binary_oled_subset_ascii_umlaut_ttf_start\n"
+    "_binary_oled_subset_ascii_umlaut_ttf_start:\n"
+    ".incbin \"" UI_HOST_TTF "\"\n"
+    ".global _binary_oled_subset_ascii_umlaut_ttf_end\n"
+    "_binary_oled_subset_ascii_umlaut_ttf_end:\n"
+    ".previous\n");
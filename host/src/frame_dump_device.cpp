@@ -0,0 +1,152 @@
+#include "frame_dump_device.h"
+
+#include <cstdio>
+#include <string>
+
+namespace muc::host
+{
+
+namespace
+{
+constexpr std::uint8_t kControlCommand = 0x00;
+constexpr std::uint8_t kControlData = 0x40;
+
+// Number of parameter bytes that follow an SSD1306 command opcode
+int parameter_count(std::uint8_t cmd)
+{
+    switch (cmd)
+    {
+    case 0x20: // memory mode
+    case 0x81: // contrast
+    case 0x8D: // charge pump
+    case 0xA8: // multiplex
+    case 0xD3: // display offset
+    case 0xD5: // clock divide
+    case 0xD9: // precharge
+    case 0xDA: // COM pins
+    case 0xDB: // VCOM detect
+        return 1;
+    case 0x21: // column address range
+    case 0x22: // page address range
+        return 2;
+    default:
+        return 0;
+    }
+}
+} // namespace
+
+esp_err_t FrameDumpDevice::write(std::span<const std::uint8_t> bytes) noexcept
+{
+    m_transactions++;
+    m_bytes += bytes.size();
+
+    if (bytes.empty())
+    {
+        return ESP_OK;
+    }
+
+    const bool is_data = bytes[0] == kControlData;
+    for (std::uint8_t b : bytes.subspan(1))
+    {
+        if (is_data)
+        {
+            data(b);
+        }
+        else
+        {
+            command(b);
+        }
+    }
+    return bytes[0] == kControlCommand || is_data ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t FrameDumpDevice::read(std::span<std::uint8_t>) noexcept
+{
+    return ESP_FAIL;
+}
+
+void FrameDumpDevice::command(std::uint8_t cmd) noexcept
+{
+    // Oled sends parameters as separate command transactions
+    if (m_pending_params > 0)
+    {
+        m_pending_params--;
+        return;
+    }
+
+    if (cmd <= 0x0F)
+    {
+        m_column = static_cast<std::uint8_t>((m_column & 0xF0) | cmd);
+    }
+    else if (cmd <= 0x1F)
+    {
+        m_column = static_cast<std::uint8_t>((m_column & 0x0F) | ((cmd & 0x0F) << 4));
+    }
+    else if (cmd >= 0xB0 && cmd <= 0xB7)
+    {
+        m_page = static_cast<std::uint8_t>(cmd & 0x07);
+    }
+    else
+    {
+        m_pending_params = parameter_count(cmd);
+    }
+}
+
+void FrameDumpDevice::data(std::uint8_t byte) noexcept
+{
+    m_ram[m_page][m_column & 0x7F] = byte;
+
+    // Horizontal addressing: wrap to the next page at the end of a RAM row
+    if (++m_column >= 128)
+    {
+        m_column = 0;
+        m_page = static_cast<std::uint8_t>((m_page + 1) & 0x07);
+    }
+}
+
+bool FrameDumpDevice::pixel(int ram_x, int ram_y) const noexcept
+{
+    if (ram_x < 0 || ram_x >= 128 || ram_y < 0 || ram_y >= 64)
+    {
+        return false;
+    }
+    return (m_ram[ram_y / 8][ram_x] >> (ram_y % 8)) & 0x1;
+}
+
+std::string FrameDumpDevice::visible_pbm_bytes(const muc::ssd1306::DisplayGeometry& g) const
+{
+    const int row_bytes = (g.width + 7) / 8;
+    std::string out(static_cast<std::size_t>(row_bytes * g.height), '\0');
+
+    for (int y = 0; y < g.height; ++y)
+    {
+        for (int x = 0; x < g.width; ++x)
+        {
+            // PBM: 1 = black. Lit OLED pixels are drawn black on white.
+            if (pixel(x + g.x_offset, y + g.y_offset))
+            {
+                out[static_cast<std::size_t>(y * row_bytes + x / 8)] |=
+                    static_cast<char>(0x80 >> (x % 8));
+            }
+        }
+    }
+    return out;
+}
+
+bool FrameDumpDevice::write_pbm(const std::string& path,
+                                const muc::ssd1306::DisplayGeometry& g) const
+{
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+    {
+        return false;
+    }
+
+    const std::string bits = visible_pbm_bytes(g);
+    std::fprintf(f, "P4\n%d %d\n", g.width, g.height);
+    const bool ok = std::fwrite(bits.data(), 1, bits.size(), f) == bits.size();
+    std::fclose(f);
+    return ok;
+}
+
+} // namespace muc::host
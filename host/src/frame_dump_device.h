@@ -0,0 +1,63 @@
+#ifndef HOST_SRC_FRAME_DUMP_DEVICE_H
+#define HOST_SRC_FRAME_DUMP_DEVICE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "II2CDevice.h"
+#include "display_geometry.h"
+
+namespace muc::host
+{
+
+// Stand-in for the SSD1306 on the I2C bus.
+//
+// Decodes the command/data stream that muc::ssd1306::Oled emits, keeps a model of the
+// controller's 128×64 GDDRAM and counts every byte that would have crossed the bus.
+class FrameDumpDevice : public muc::II2CDevice
+{
+  public:
+    FrameDumpDevice() noexcept = default;
+
+    esp_err_t write(std::span<const std::uint8_t> data) noexcept override;
+    esp_err_t read(std::span<std::uint8_t> data) noexcept override;
+
+    std::uint64_t bytes_written() const noexcept
+    {
+        return m_bytes;
+    }
+
+    std::uint64_t transactions() const noexcept
+    {
+        return m_transactions;
+    }
+
+    bool pixel(int ram_x, int ram_y) const noexcept;
+
+    // Writes the visible window of `g` as a binary PBM (P4)
+    bool write_pbm(const std::string& path, const muc::ssd1306::DisplayGeometry& g) const;
+
+    // Packs the visible window of `g` exactly like write_pbm() does (rows MSB-first)
+    std::string visible_pbm_bytes(const muc::ssd1306::DisplayGeometry& g) const;
+
+  private:
+    void command(std::uint8_t byte) noexcept;
+    void data(std::uint8_t byte) noexcept;
+
+    std::array<std::array<std::uint8_t, 128>, 8> m_ram{};
+    std::uint8_t m_page = 0;
+    std::uint8_t m_column = 0;
+
+    // Parameter bytes still expected by the last multi-byte command
+    int m_pending_params = 0;
+
+    std::uint64_t m_bytes = 0;
+    std::uint64_t m_transactions = 0;
+};
+
+} // namespace muc::host
+
+#endif // HOST_SRC_FRAME_DUMP_DEVICE_H
@@ -0,0 +1,375 @@
+// Headless runner for the LVGL UI.
+//
+// Drives the real ui and lvgl_driver components against a FrameDumpDevice on a
+// virtual millisecond clock, dumps every frame that reaches the "panel" as PBM and
+// reports render time and bus bytes per frame, then the peak use of the LVGL arena.
+// With --golden the frames are compared against previously recorded ones, and with
+// --max-arena-pct the arena peak against LV_MEM_SIZE. Scenarios may also check the
+// counter label text at given times (non-zero exit status on any failure).
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "display_geometry.h"
+#include "frame_dump_device.h"
+#include "lvgl.h"
+#include "lvgl_driver.h"
+#include "ssd1306.h"
+#include "ui_api.h"
+#include "ui_consumer_task.h"
+#include "ui_queue.h"
+#include "ui_widget_registry.h"
+
+namespace
+{
+
+using muc::ssd1306::kDefaultGeometry;
+
+// Same payload shape as Provision::start_provisioning()
+constexpr std::string_view kQrPayload =
+    R"({"ver":"v1","name":"PROV_A1B2C3","pop":"abcd1234","transport":"ble"})";
+
+struct Step
+{
+    std::uint32_t at_ms;
+    std::function<void(muc::ui::UiApi&)> action;
+};
+
+// Expected counter label text right after the handler pass at `at_ms`
+struct Check
+{
+    std::uint32_t at_ms;
+    std::string_view counter;
+};
+
+struct Scenario
+{
+    std::string_view name;
+    std::uint32_t duration_ms;
+    std::vector<Step> steps;
+    std::vector<Check> checks = {};
+};
+
+void set_number_from_isr(muc::ui::UiApi& ui, std::int32_t value)
+{
+    BaseType_t woken = pdFALSE;
+    (void)ui.set_number_from_isr(value, &woken);
+}
+
+std::vector<Scenario> make_scenarios()
+{
+    std::vector<Scenario> list;
+
+    list.push_back({"boot", 200, {}});
+
+    list.push_back({"provision_qr",
+                    500,
+                    {{0, [](muc::ui::UiApi& ui) { ui.show_provision_qr(kQrPayload); }}}});
+
+    list.push_back({"status_marquee",
+                    3000,
+                    {{0, [](muc::ui::UiApi& ui) { ui.show_provision_qr(kQrPayload); }},
+                     {100, [](muc::ui::UiApi& ui) { ui.set_status("192.168.100.200"); }}}});
+
+    Scenario counter{"counter", 5000, {{0, [](muc::ui::UiApi& ui) { ui.set_status("10.0.0.7"); }}}};
+    for (std::uint32_t i = 0; i < 5; ++i)
+    {
+        counter.steps.push_back({i * 1000 + 10,
+                                 [i](muc::ui::UiApi& ui)
+                                 { ui.set_text(std::to_string(i)); }});
+    }
+    list.push_back(std::move(counter));
+
+    // ISR commands reach the mailbox only when the queue is drained, after task commands
+    // posted in the meantime; the one submitted last must win either way, also when
+    // set_text() and a number compete for the counter label
+    list.push_back({"isr_order",
+                    500,
+                    {{0, [](muc::ui::UiApi& ui) { set_number_from_isr(ui, 1); }},
+                     {0, [](muc::ui::UiApi& ui) { ui.set_number(2); }},
+                     {100, [](muc::ui::UiApi& ui) { ui.set_number(3); }},
+                     {100, [](muc::ui::UiApi& ui) { set_number_from_isr(ui, 4); }},
+                     {200, [](muc::ui::UiApi& ui) { set_number_from_isr(ui, 5); }},
+                     {200, [](muc::ui::UiApi& ui) { ui.set_number(6); }},
+                     {300, [](muc::ui::UiApi& ui) { set_number_from_isr(ui, 7); }},
+                     {300, [](muc::ui::UiApi& ui) { ui.set_text("text"); }},
+                     {400, [](muc::ui::UiApi& ui) { ui.set_text("more text"); }},
+                     {400, [](muc::ui::UiApi& ui) { set_number_from_isr(ui, 8); }}},
+                    {{0, "2"}, {100, "4"}, {200, "6"}, {300, "text"}, {400, "8"}}});
+
+    return list;
+}
+
+// LVGL runs on the virtual clock so frames are reproducible
+std::uint32_t s_now_ms = 0;
+
+std::uint32_t virtual_tick()
+{
+    return s_now_ms;
+}
+
+struct FrameRecord
+{
+    std::uint32_t at_ms;
+    std::uint32_t render_us;
+    std::uint64_t bus_bytes;
+    bool golden_match;
+};
+
+std::string frame_name(std::string_view scenario, std::size_t index)
+{
+    std::array<char, 16> num{};
+    std::snprintf(num.data(), num.size(), "%03zu", index);
+    return std::string(scenario) + "_" + num.data() + ".pbm";
+}
+
+bool golden_matches(const std::filesystem::path& path, const std::string& bits)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+
+    // Skip the two header lines ("P4", "<w> <h>")
+    std::string line;
+    std::getline(in, line);
+    std::getline(in, line);
+    const std::string golden((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+    return golden == bits;
+}
+
+// Frames recorded for `scenario` in `dir`, so a run that produces fewer frames fails too
+std::size_t golden_count(const std::filesystem::path& dir, std::string_view scenario)
+{
+    std::size_t count = 0;
+    while (std::filesystem::exists(dir / frame_name(scenario, count)))
+    {
+        count++;
+    }
+    return count;
+}
+
+void usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s --scenario NAME [--out DIR] [--golden DIR] [--max-arena-pct N]\n"
+                 "scenarios: boot, provision_qr, status_marquee, counter, isr_order\n",
+                 argv0);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string_view scenario_name;
+    std::filesystem::path out_dir = "frames";
+    std::filesystem::path golden_dir;
+    int max_arena_pct = 100;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--scenario" && i + 1 < argc)
+        {
+            scenario_name = argv[++i];
+        }
+        else if (arg == "--out" && i + 1 < argc)
+        {
+            out_dir = argv[++i];
+        }
+        else if (arg == "--golden" && i + 1 < argc)
+        {
+            golden_dir = argv[++i];
+        }
+        else if (arg == "--max-arena-pct" && i + 1 < argc)
+        {
+            max_arena_pct = std::atoi(argv[++i]);
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // One scenario per process: the UI keeps its widgets in statics
+    const auto scenarios = make_scenarios();
+    const Scenario* scenario = nullptr;
+    for (const auto& s : scenarios)
+    {
+        if (s.name == scenario_name)
+        {
+            scenario = &s;
+        }
+    }
+    if (!scenario)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::filesystem::create_directories(out_dir);
+
+    // --- Same wiring as app_main, with the I2C device replaced -----------------
+    static muc::host::FrameDumpDevice panel;
+    static muc::ssd1306::Oled oled(panel, kDefaultGeometry);
+
+    muc::lvgl_driver::lvgl_driver_init();
+    lv_tick_set_cb(virtual_tick);
+
+    static std::array<std::uint8_t, muc::ssd1306::kVisibleLvglBufferBytes> lvgl_buf{};
+    static muc::lvgl_driver::LvglDisplay display(oled, lvgl_buf);
+    muc::lvgl_driver::display_manager().add(display);
+
+    static muc::ui::UiQueue ui_queue{20};
+    static muc::ui::UiApi ui_api{ui_queue};
+    muc::ui::UiConsumerTask::create_widgets();
+
+    // --- Run ---------------------------------------------------------------------
+    std::vector<FrameRecord> frames;
+    std::size_t next_step = 0;
+    std::uint64_t last_bus_bytes = panel.bytes_written();
+    std::uint32_t last_frame_count = display.governor().stats().frames;
+    std::uint32_t pending_render_us = 0;
+    bool all_match = true;
+    std::size_t next_check = 0;
+    bool checks_ok = true;
+
+    for (s_now_ms = 0; s_now_ms <= scenario->duration_ms; ++s_now_ms)
+    {
+        while (next_step < scenario->steps.size() &&
+               scenario->steps[next_step].at_ms <= s_now_ms)
+        {
+            scenario->steps[next_step++].action(ui_api);
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        (void)muc::ui::UiConsumerTask::handler_pass(ui_queue, 0, 0);
+        const auto pass_us = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0)
+                .count());
+
+        while (next_check < scenario->checks.size() &&
+               scenario->checks[next_check].at_ms <= s_now_ms)
+        {
+            const Check& check = scenario->checks[next_check++];
+            const char* shown = lv_label_get_text(muc::ui::UiConsumerTask::widgets().get(
+                muc::ui::UiWidgetId::CounterLabel));
+            if (check.counter != shown)
+            {
+                std::printf("# check at %" PRIu32 " ms: counter shows \"%s\", expected \"%.*s\"\n",
+                            s_now_ms,
+                            shown,
+                            static_cast<int>(check.counter.size()),
+                            check.counter.data());
+                checks_ok = false;
+            }
+        }
+
+        const std::uint32_t frame_count = display.governor().stats().frames;
+        if (frame_count != last_frame_count)
+        {
+            last_frame_count = frame_count;
+            pending_render_us = pass_us;
+        }
+
+        // A frame counts once it has been pushed over the bus
+        if (panel.bytes_written() == last_bus_bytes)
+        {
+            continue;
+        }
+
+        FrameRecord rec{.at_ms = s_now_ms,
+                        .render_us = pending_render_us,
+                        .bus_bytes = panel.bytes_written() - last_bus_bytes,
+                        .golden_match = true};
+        last_bus_bytes = panel.bytes_written();
+        pending_render_us = 0;
+
+        const std::string name = frame_name(scenario->name, frames.size());
+        panel.write_pbm((out_dir / name).string(), kDefaultGeometry);
+
+        if (!golden_dir.empty())
+        {
+            rec.golden_match =
+                golden_matches(golden_dir / name, panel.visible_pbm_bytes(kDefaultGeometry));
+            all_match = all_match && rec.golden_match;
+        }
+        frames.push_back(rec);
+    }
+
+    if (!golden_dir.empty())
+    {
+        const std::size_t recorded = golden_count(golden_dir, scenario->name);
+        if (recorded != frames.size())
+        {
+            std::printf("# golden: %zu frames recorded in %s, %zu produced\n",
+                        recorded,
+                        golden_dir.string().c_str(),
+                        frames.size());
+            all_match = false;
+        }
+    }
+
+    // --- Report ------------------------------------------------------------------
+    std::printf("frame,at_ms,render_us,bus_bytes%s\n", golden_dir.empty() ? "" : ",golden");
+    std::uint64_t total_render = 0;
+    std::uint64_t total_bytes = 0;
+    std::uint32_t max_render = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        const auto& f = frames[i];
+        std::printf("%zu,%" PRIu32 ",%" PRIu32 ",%" PRIu64 "%s\n",
+                    i,
+                    f.at_ms,
+                    f.render_us,
+                    f.bus_bytes,
+                    golden_dir.empty() ? "" : (f.golden_match ? ",ok" : ",MISMATCH"));
+        total_render += f.render_us;
+        total_bytes += f.bus_bytes;
+        max_render = std::max(max_render, f.render_us);
+    }
+
+    const std::size_t n = std::max<std::size_t>(frames.size(), 1);
+    std::printf("# %.*s: %zu frames, render avg %" PRIu64 " us max %" PRIu32
+                " us, bus avg %" PRIu64 " B total %" PRIu64 " B\n",
+                static_cast<int>(scenario->name.size()),
+                scenario->name.data(),
+                frames.size(),
+                total_render / n,
+                max_render,
+                total_bytes / n,
+                total_bytes);
+
+    // High-water mark of the whole run: all screens are built up front, so this is what
+    // LV_MEM_SIZE has to cover (plus fragmentation). Host pointers are 8 bytes, so it is an
+    // upper bound for the target.
+    lv_mem_monitor_t mon{};
+    lv_mem_monitor(&mon);
+    const auto peak = static_cast<std::size_t>(mon.max_used);
+    const auto total = std::max<std::size_t>(mon.total_size, 1);
+    const bool arena_ok = peak * 100 <= static_cast<std::size_t>(max_arena_pct) * total;
+    std::printf("# arena: peak %zu of %zu bytes (%zu%%), largest free block %zu%s\n",
+                peak,
+                total,
+                peak * 100 / total,
+                static_cast<std::size_t>(mon.free_biggest_size),
+                arena_ok ? "" : ", OVER BUDGET");
+
+    return all_match && checks_ok && arena_ok ? 0 : 1;
+}
@@ -19,7 +19,9 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char* pcTaskName);
 // Called by FreeRTOS when the idle task runs (CPU0 idle).
 void vApplicationIdleHook(void);
 
-// Our own debug/monitoring task that periodically logs stack usage.
+// Our own debug/monitoring task that periodically logs memory, display and UI stats,
+// plus CPU and stack usage when FreeRTOS run-time stats are enabled
+// (CONFIG_APP_TELEMETRY starts it).
 void stack_monitor_task(void* arg);
 
 #ifdef __cplusplus
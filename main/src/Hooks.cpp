@@ -1,5 +1,6 @@
 #include "Hooks.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -11,6 +12,14 @@
 
 #include <esp_heap_caps.h>
 #include <esp_log.h>
+#include <sdkconfig.h>
+
+#include "lvgl_driver.h"
+#include "ui_metrics.h"
+
+#if CONFIG_FONTS_FREETYPE
+#include "FontMemory.h"
+#endif
 
 namespace
 {
@@ -98,13 +107,154 @@ void monitor_heap_usage()
     ESP_LOGI("MEMORY", "Largest Contiguous Block: %lu bytes", (unsigned long)largest_block);
 }
 
+void monitor_lvgl_heap_usage()
+{
+    // LVGL allocates from its own static arena (LV_MEM_SIZE), invisible to heap_caps
+    const auto stats = muc::lvgl_driver::memory_stats();
+    if (stats.total_bytes == 0)
+    {
+        return;
+    }
+
+    const std::uint32_t used = stats.total_bytes - stats.free_bytes;
+
+    ESP_LOGI("MEMORY", "--- LVGL Heap (Static Arena) ---");
+    ESP_LOGI("MEMORY", "Total: %lu bytes", (unsigned long)stats.total_bytes);
+    ESP_LOGI("MEMORY", "Used : %lu bytes (%u%%)", (unsigned long)used, stats.used_pct);
+    ESP_LOGI("MEMORY", "Max Used: %lu bytes", (unsigned long)stats.max_used_bytes);
+    ESP_LOGI("MEMORY",
+             "Largest Free Block: %lu bytes (frag %u%%)",
+             (unsigned long)stats.largest_free_block,
+             stats.frag_pct);
+}
+
+void monitor_font_heap_usage()
+{
+#if CONFIG_FONTS_FREETYPE
+    // FreeType allocates from its own static arena (CONFIG_FONTS_FREETYPE_ARENA_BYTES)
+    const auto stats = muc::fonts::font_memory_stats();
+
+    ESP_LOGI("MEMORY", "--- FreeType Heap (Static Arena) ---");
+    ESP_LOGI("MEMORY", "Total: %lu bytes", (unsigned long)stats.total_bytes);
+    ESP_LOGI("MEMORY",
+             "Used : %lu bytes in %lu blocks",
+             (unsigned long)stats.used_bytes,
+             (unsigned long)stats.allocations);
+    ESP_LOGI("MEMORY", "Max Used: %lu bytes", (unsigned long)stats.peak_bytes);
+    ESP_LOGI("MEMORY",
+             "Largest Free Block: %lu bytes, failed allocations: %lu",
+             (unsigned long)stats.largest_free_block,
+             (unsigned long)stats.failed);
+#endif
+}
+
+void monitor_frame_pacing()
+{
+    const auto& displays = muc::lvgl_driver::display_manager();
+    static_assert(muc::lvgl_driver::kFrameTimeBuckets == 6, "update the histogram log line");
+
+    for (std::size_t i = 0; i < displays.size(); ++i)
+    {
+        const auto stats = displays.display(i)->governor().stats();
+        const auto& hist = stats.frame_time_hist;
+
+        ESP_LOGI("DISPLAY", "--- Frame Governor (panel %u) ---", static_cast<unsigned>(i));
+        ESP_LOGI("DISPLAY",
+                 "FPS target/achieved: %lu/%lu%s",
+                 (unsigned long)stats.target_fps,
+                 (unsigned long)stats.achieved_fps,
+                 stats.idle ? " (idle)" : "");
+        ESP_LOGI("DISPLAY",
+                 "Frames: %lu, dropped: %lu, idle periods: %lu, max frame: %lu us",
+                 (unsigned long)stats.frames,
+                 (unsigned long)stats.dropped,
+                 (unsigned long)stats.idle_periods,
+                 (unsigned long)stats.max_frame_us);
+        ESP_LOGI("DISPLAY",
+                 "Frame ms <5:%lu <10:%lu <20:%lu <40:%lu <80:%lu >=80:%lu",
+                 (unsigned long)hist[0],
+                 (unsigned long)hist[1],
+                 (unsigned long)hist[2],
+                 (unsigned long)hist[3],
+                 (unsigned long)hist[4],
+                 (unsigned long)hist[5]);
+    }
+}
+
+void monitor_ui_updates()
+{
+    const auto stats = muc::ui::UiMetrics::stats();
+    const std::uint32_t updates = stats.updates ? stats.updates : 1;
+
+    ESP_LOGI("UI", "--- UI Updates (%s mode) ---", stats.lock_mode ? "lock" : "queue");
+    ESP_LOGI("UI",
+             "Updates: %lu (%lu superseded, %lu unchanged), msg->pixel latency avg/max: "
+             "%lu/%lu us",
+             (unsigned long)stats.updates,
+             (unsigned long)stats.superseded,
+             (unsigned long)stats.unchanged,
+             (unsigned long)stats.latency_avg_us,
+             (unsigned long)stats.latency_max_us);
+    static constexpr const char* kLaneNames[] = {"urgent", "bulk"};
+    for (std::size_t i = 0; i < stats.lanes.size(); ++i)
+    {
+        const auto& lane = stats.lanes[i];
+        ESP_LOGI("UI",
+                 "  %-6s: %lu updates, latency avg/max %lu/%lu us, %lu superseded, %lu refused",
+                 kLaneNames[i],
+                 (unsigned long)lane.updates,
+                 (unsigned long)lane.latency_avg_us,
+                 (unsigned long)lane.latency_max_us,
+                 (unsigned long)lane.superseded,
+                 (unsigned long)lane.refused);
+    }
+    ESP_LOGI("UI",
+             "CPU producer: %llu us (%lu us/update), handler: %llu us over %lu passes",
+             (unsigned long long)stats.producer_busy_us,
+             (unsigned long)(stats.producer_busy_us / updates),
+             (unsigned long long)stats.handler_busy_us,
+             (unsigned long)stats.handler_passes);
+    const auto screen_heap = [&stats](muc::ui::UiScreenId id)
+    { return (unsigned long)stats.screen_heap_bytes[static_cast<std::size_t>(id)]; };
+    ESP_LOGI("UI",
+             "Screens: provisioning %lu B, status %lu B (LVGL heap), %lu switches",
+             screen_heap(muc::ui::UiScreenId::Provisioning),
+             screen_heap(muc::ui::UiScreenId::Status),
+             (unsigned long)stats.screen_switches);
+    if (stats.drain_passes > 0)
+    {
+        ESP_LOGI("UI",
+                 "Drain: %lu passes, msgs/pass avg/max %lu/%lu, queue high-water %lu",
+                 (unsigned long)stats.drain_passes,
+                 (unsigned long)stats.messages_per_pass_avg,
+                 (unsigned long)stats.messages_per_pass_max,
+                 (unsigned long)stats.queue_high_water);
+    }
+    if (stats.lock_acquisitions > 0)
+    {
+        ESP_LOGI("UI",
+                 "Lock: %lu taken, %lu contended, wait max %lu us, hold avg/max %lu/%lu us",
+                 (unsigned long)stats.lock_acquisitions,
+                 (unsigned long)stats.lock_contended,
+                 (unsigned long)stats.lock_wait_max_us,
+                 (unsigned long)stats.lock_hold_avg_us,
+                 (unsigned long)stats.lock_hold_max_us);
+    }
+}
+
 extern "C" void stack_monitor_task(void* arg)
 {
     (void)arg;
 
-#if (configUSE_TRACE_FACILITY == 1 && configGENERATE_RUN_TIME_STATS == 1)
+#if !(configUSE_TRACE_FACILITY == 1 && configGENERATE_RUN_TIME_STATS == 1)
+    ESP_LOGW(TAG,
+             "CPU and stack stats need configUSE_TRACE_FACILITY and "
+             "configGENERATE_RUN_TIME_STATS in menuconfig");
+#endif
+
     while (true)
     {
+#if (configUSE_TRACE_FACILITY == 1 && configGENERATE_RUN_TIME_STATS == 1)
         UBaseType_t task_count = uxTaskGetNumberOfTasks();
         auto* task_array =
             static_cast<TaskStatus_t*>(pvPortMalloc(task_count * sizeof(TaskStatus_t)));
@@ -136,15 +286,19 @@ extern "C" void stack_monitor_task(void* arg)
         {
             ESP_LOGE(TAG, "Memory allocation failed");
         }
+#endif
 
         // 3. Heap Usage Monitor
         monitor_heap_usage();
+        monitor_lvgl_heap_usage();
+        monitor_font_heap_usage();
 
-        vTaskDelay(pdMS_TO_TICKS(5000));
+        // 4. Display refresh pacing
+        monitor_frame_pacing();
+
+        // 5. UI update path (queue vs lock mode)
+        monitor_ui_updates();
+
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_APP_TELEMETRY_PERIOD_MS));
     }
-#else
-    ESP_LOGW(TAG,
-             "Enable configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS in menuconfig");
-    vTaskDelete(nullptr);
-#endif
-}
\ No newline at end of file
+}
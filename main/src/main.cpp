@@ -1,12 +1,11 @@
 #include <array>
-#include <cinttypes>
 #include <cstdint>
-#include <cstdio>
 #include <string_view>
 
 #include <esp_log.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <sdkconfig.h>
 
 #include "Hooks.h"
 #include "I2CBus.h"
@@ -30,15 +29,35 @@ extern "C" void app_main()
     static muc::I2CDevice oled_slave(bus, muc::ssd1306::OLED_ADDR, muc::I2C1_FREQ);
     static muc::ssd1306::Oled oled(oled_slave, muc::ssd1306::kDefaultGeometry);
     oled.set_scan_mode(true);
-    muc::lvgl_driver::lvgl_driver_init(oled);
+
+    muc::lvgl_driver::lvgl_driver_init();
+    auto& displays = muc::lvgl_driver::display_manager();
+
+    // Primary panel: hosts the UI (LVGL default display)
+    static std::array<std::uint8_t, muc::ssd1306::kVisibleLvglBufferBytes> lvgl_buf{};
+    static muc::lvgl_driver::LvglDisplay main_display(oled, lvgl_buf);
+    displays.add(main_display);
+
+    // Optional second panel on the same bus
+    if (bus.probe(muc::ssd1306::OLED_ADDR_SECONDARY))
+    {
+        static muc::I2CDevice oled2_slave(bus, muc::ssd1306::OLED_ADDR_SECONDARY, muc::I2C1_FREQ);
+        static muc::ssd1306::Oled oled2(oled2_slave, muc::ssd1306::kDefaultGeometry);
+        static std::array<std::uint8_t, muc::ssd1306::kVisibleLvglBufferBytes> lvgl_buf2{};
+        static muc::lvgl_driver::LvglDisplay second_display(oled2, lvgl_buf2);
+        if (displays.add(second_display))
+        {
+            ESP_LOGI(TAG, "Second OLED found at 0x%02X", muc::ssd1306::OLED_ADDR_SECONDARY);
+        }
+    }
 
     // 1. Initialize the Message Queue and API
     static muc::ui::UiQueue ui_queue{20};
     static muc::ui::UiApi ui_api{ui_queue};
 
-    // 2. Configure LVGL Task with your original timing values
+    // 2. Configure LVGL Task; the refresh rate itself is capped by the frame governor
     static constexpr muc::ui::LvglTaskConfig lvgl_task_cfg = {
-        .tick_period_ms = 20, .handler_period_ms = 40, .user_data = &ui_queue};
+        .tick_period_ms = 20, .min_handler_period_ms = 10, .user_data = &ui_queue};
 
     // 3. Start LVGL Tasks with requested stack sizes
     xTaskCreate(muc::ui::UiConsumerTask::lvgl_handler_task,
@@ -64,6 +83,10 @@ extern "C" void app_main()
     // xTaskCreate(muc::fonts::font_test_task, "font_test_task", 2048, &oled, 5, nullptr);
     // xTaskCreate(muc::fonts::font_rotate_task, "font_rotate_task", 2048, &oled, 5, nullptr);
 
+#if CONFIG_APP_TELEMETRY
+    xTaskCreate(stack_monitor_task, "monitor", 4 * 1024, nullptr, 1, nullptr);
+#endif
+
     vTaskDelay(pdMS_TO_TICKS(100));
 
     // 6. Initialize Provisioning with UI Callbacks
@@ -84,10 +107,8 @@ extern "C" void app_main()
     auto i = std::int32_t{0};
     while (true)
     {
-        auto buf = std::array<char, 16>{};
-        // Use PRIi32 to portably print std::int32_t
-        std::snprintf(buf.data(), buf.size(), "%" PRIi32, i++);
-        ui_api.set_text(std::string_view{buf.data()});
+        // Formatted by the LVGL task, not here
+        ui_api.set_number(i++);
 
         vTaskDelay(pdMS_TO_TICKS(1000));
     }